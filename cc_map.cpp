@@ -0,0 +1,109 @@
+/*  cc_map.cpp  ───────────────────────────────────────────────────────────
+    CC number → hw::Param lookup (see cc_map.h)
+    ---------------------------------------------------------------------- */
+
+#include "cc_map.h"
+#include "hw_inputs.h"
+#include "midi_port.h"
+#include <avr/pgmspace.h>
+
+namespace {
+
+    constexpr uint8_t NONE = 0xFF;
+
+    /* CC 20 + n = hw::Param n, in enum order; everything else unmapped.
+       Edit freely – lookup cost does not depend on how many are mapped. */
+    #define QM_CC(n) ((n) >= 20 && (n) < 20 + (uint8_t)hw::Param::Count ? (n) - 20 : NONE)
+    #define QM_CC8(n) QM_CC(n),QM_CC(n+1),QM_CC(n+2),QM_CC(n+3), \
+                      QM_CC(n+4),QM_CC(n+5),QM_CC(n+6),QM_CC(n+7)
+    const uint8_t kCcToParam[128] PROGMEM = {
+        QM_CC8(  0), QM_CC8(  8), QM_CC8( 16), QM_CC8( 24),
+        QM_CC8( 32), QM_CC8( 40), QM_CC8( 48), QM_CC8( 56),
+        QM_CC8( 64), QM_CC8( 72), QM_CC8( 80), QM_CC8( 88),
+        QM_CC8( 96), QM_CC8(104), QM_CC8(112), QM_CC8(120),
+    };
+    #undef QM_CC8
+    #undef QM_CC
+
+    void onControlChange(midi::Channel ch, midi::DataByte num, midi::DataByte val)
+    {
+        cc::handle(ch, num, val);
+    }
+}
+
+void cc::init()
+{
+    setChannel(16);                       // remote-only Param, no pot to seed it
+    MIDI.setHandleControlChange(onControlChange);
+}
+
+void cc::setChannel(uint8_t ch)    { if (ch >= 1 && ch <= 16) hw::pots.ccChannel = ch; }
+uint8_t cc::channel()              { return hw::pots.ccChannel; }
+
+void cc::handle(uint8_t ch, uint8_t num, uint8_t val)
+{
+    if (ch != hw::pots.ccChannel) return;
+    uint8_t p = pgm_read_byte(&kCcToParam[num & 0x7F]);
+    if (p != NONE) hw::setParam(hw::Param(p), val);
+}
+
+#if CC_BENCH
+uint16_t TapSerial::benchLeft = 0;
+byte   (*TapSerial::benchByte)() = nullptr;
+
+namespace {
+    constexpr uint16_t kBenchN = 4096;
+    uint16_t benchPos = 0;
+
+    uint8_t benchCc (uint16_t i) { return 20 + i % (uint8_t)hw::Param::Count; }
+
+    /* message i as three wire bytes, full status every time (no running status) */
+    byte benchWire()
+    {
+        uint16_t i = benchPos / 3;
+        uint8_t  r = benchPos % 3;
+        ++benchPos;
+        return r == 0 ? byte(0xB0 | ((hw::pots.ccChannel - 1) & 0x0F))
+             : r == 1 ? byte(benchCc(i))
+                      : byte(i & 0x7F);
+    }
+
+    void put21(uint8_t* p, unsigned long v)        // 21 bits, 7 per byte, LSB first
+    {
+        for (uint8_t n = 0; n < 3; ++n, v >>= 7) p[n] = v & 0x7F;
+    }
+}
+
+/* dense stream: every mapped CC, full sweep – once through handle() alone,
+   once as wire bytes through MIDI.read() (parser + callback).  The port
+   is a MIDI output, so the result goes out as one SysEx frame:
+     F0 7D 51 7E <msgs> <µs handle> <µs parser> F7   (each 3 × 7 bit)    */
+void cc::bench()
+{
+    hw::PotValues keep = hw::pots;
+
+    unsigned long t0 = micros();
+    for (uint16_t i = 0; i < kBenchN; ++i)
+        handle(ctlChannel, benchCc(i), i & 0x7F);
+    unsigned long dtHandle = micros() - t0;
+
+    MIDI.turnThruOff();                          // no echo of the fake stream
+    benchPos            = 0;
+    TapSerial::benchByte = benchWire;
+    TapSerial::benchLeft = 3 * kBenchN;
+    t0 = micros();
+    while (TapSerial::benchLeft) MIDI.read();
+    unsigned long dtParse = micros() - t0;
+    MIDI.turnThruOn();
+
+    hw::pots = keep;                             // undo the sweep …
+    hw::releaseAll();                            // … and give every field back to its pot
+
+    uint8_t msg[13] = { 0xF0, 0x7D, 0x51, 0x7E };
+    put21(msg + 4,  kBenchN);
+    put21(msg + 7,  dtHandle);
+    put21(msg + 10, dtParse);
+    msg[12] = 0xF7;
+    MIDI.sendSysEx(sizeof msg, msg, true);
+}
+#endif
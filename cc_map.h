@@ -0,0 +1,27 @@
+#pragma once
+#include <Arduino.h>
+
+/*  cc_map.h  ─────────────────────────────────────────────────────────────
+    MIDI CC remote control of every hw::Param.  One 128-byte PROGMEM
+    table maps CC number → Param, so a message costs one flash read no
+    matter how many parameters are mapped.  Values go through
+    hw::setParam() – CC 0 is the field minimum, 127 its maximum, for
+    every row – and are held against the pot (soft takeover).
+    ---------------------------------------------------------------------- */
+
+#ifndef CC_BENCH
+#define CC_BENCH     0        // ← set 1 (or -DCC_BENCH=1) to time a dense CC burst at boot
+#endif
+
+namespace cc {
+
+    void    init();                       // hook the MIDI CC handler
+    void    setChannel(uint8_t ch);       // 1-16, default 16 (Param CcChannel)
+    uint8_t channel();
+
+    void    handle(uint8_t ch, uint8_t num, uint8_t val);   // the fixed-cost path
+
+#if CC_BENCH
+    void    bench();                      // reports µs as SysEx F0 7D 51 7E … F7
+#endif
+}
@@ -0,0 +1,130 @@
+/*  chain.cpp  ────────────────────────────────────────────────────────────
+    Song / chain mode – prefetch one entry ahead, swap on the loop seam
+    ---------------------------------------------------------------------- */
+
+#include "chain.h"
+#include "sequencer.h"
+#include "pattern_store.h"
+#include "hw_inputs.h"
+
+namespace {
+    chain::Entry entries[chain::kMaxEntries];
+    uint8_t count = 0;
+
+    enum class St : uint8_t { Idle, Start, Prefetch, Armed, Scheduled };
+    St      state     = St::Idle;
+    uint8_t cur       = 0;          // entry now playing
+    uint8_t nxt       = 0;          // entry sitting in the idle bank
+    uint8_t loopMark  = 0;          // seq::loops() when `cur` began
+    uint8_t loadMark  = 0;          // seq::loads() when the Load was queued
+    uint8_t mode      = 0;          // hw::pots.chainMode last seen
+
+    inline uint8_t after(uint8_t i) { return (i + 1) % count; }
+
+    /* decode entry i into the idle bank; skips empty slots (at most one lap) */
+    bool prefetch(uint8_t i)
+    {
+        for (uint8_t n = 0; n < count; ++n, i = after(i)) {
+            if (store::stage(entries[i].slot)) {
+                seq::stageLoop(entries[i].loopStart, entries[i].loopEnd);
+                nxt = i;
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+void chain::clear()   { stop(); count = 0; }
+uint8_t chain::length() { return count; }
+chain::Entry chain::entry(uint8_t i) { return entries[i % kMaxEntries]; }
+
+bool chain::append(const Entry& e)
+{
+    if (count >= kMaxEntries) return false;
+    entries[count] = e;
+    if (!entries[count].repeats) entries[count].repeats = 1;
+    ++count;
+    return true;
+}
+
+void chain::program(const uint8_t* f)
+{
+    constexpr uint8_t CLEAR = 0x7F;
+    if (f[0] == 0 || f[0] == CLEAR) clear();
+    if (f[0] == CLEAR || f[0] != count) return;
+
+    Entry e = { f[1], f[2], f[3], f[4] };
+    if (e.slot >= store::kSlots || e.loopStart > 16 || e.loopEnd > 16) return;
+    if (!e.loopStart != !e.loopEnd) return;       // both 0 = follow the pots
+    append(e);
+}
+
+void chain::start()
+{
+    if (!count)                                   // default song: every slot × 4
+        for (uint8_t s = 0; s < store::kSlots; ++s) append({ s, 4, 0, 0 });
+    state = St::Start;                            // service() decodes entry 0
+}
+
+void chain::stop()
+{
+    /* an entry already in the idle bank must not land after we stopped */
+    if (state == St::Armed || state == St::Scheduled) {
+        seq::cancel(seq::Action::Load);
+        seq::dropStaged();
+    }
+    state = St::Idle;
+    seq::setLoopOverride(0, 0);
+}
+
+bool chain::running() { return state != St::Idle; }
+
+/* ───────── service() – all the work happens here, off the clock edge ── */
+void chain::service()
+{
+    if (hw::pots.chainMode != mode) {             // CC / SysEx / console toggles it
+        mode = hw::pots.chainMode;
+        if (mode) start(); else stop();
+    }
+
+    switch (state) {
+    case St::Idle:
+        return;
+
+    case St::Start:                           // entry 0 goes in on the next step
+        if (store::busy()) return;
+        if (!prefetch(0)) { stop(); return; }
+        seq::scheduleAt(seq::Action::Load, seq::Quant::NextStep);
+        loadMark = seq::loads();
+        state    = St::Scheduled;
+        return;
+
+    case St::Scheduled:                       // waiting for the swap
+        if (seq::loads() == loadMark) {
+            /* someone else (SysEx load) reused the idle bank – fetch again */
+            if (!seq::hasStaged()) state = St::Prefetch;
+            return;
+        }
+        cur      = nxt;
+        loopMark = seq::loops();
+        state    = St::Prefetch;
+        /* fall through – prefetch right away, a whole entry ahead */
+
+    case St::Prefetch:
+        if (store::busy()) return;            // EEPROM reads would wait on the writer
+        if (!prefetch(after(cur))) { stop(); return; }
+        state = St::Armed;
+        /* fall through */
+
+    case St::Armed: {
+        /* queue the Load for the seam that ends the last repeat */
+        uint8_t passes = seq::loops() - loopMark;
+        if (passes + 1 < entries[cur].repeats) return;
+        seq::scheduleAt(seq::Action::Load, seq::Quant::LoopStart);
+        loadMark = seq::loads();
+        state    = St::Scheduled;
+        return;
+    }
+    }
+}
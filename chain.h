@@ -0,0 +1,38 @@
+#pragma once
+#include <Arduino.h>
+
+/*  chain.h  ──────────────────────────────────────────────────────────────
+    Song / chain mode.  A list of (pattern slot, repeats, loop range)
+    entries played in order.  The next entry is decoded into the
+    sequencer's idle bank as soon as the current one starts, and a Load
+    is queued for the loop seam of its last repeat – the switch itself
+    is a pointer swap inside nextStep().
+    ---------------------------------------------------------------------- */
+
+namespace chain {
+
+    struct Entry {
+        uint8_t slot;           // store:: pattern slot
+        uint8_t repeats;        // passes through the loop (≥ 1)
+        uint8_t loopStart;      // 1-16, 0 = follow the pots
+        uint8_t loopEnd;        // 1-16
+    };
+
+    constexpr uint8_t kMaxEntries = 16;
+
+    void    clear();
+    bool    append(const Entry& e);       // false when full
+
+    /* SysEx cmd 04 payload: index, slot, repeats, loopStart, loopEnd.
+       Index 0 starts a new list, 0x7F only clears it; other entries
+       must arrive in order (index == length()).  Clearing stops a
+       running chain – toggle the Chain Param to start the new list. */
+    void    program(const uint8_t* entry);
+    uint8_t length();
+    Entry   entry(uint8_t i);
+
+    void    start();                      // from entry 0; empty list = every slot × 4
+    void    stop();                       // back to pots + live pattern
+    bool    running();
+    void    service();                    // call each loop(): Param edge, prefetch + arm
+}
@@ -5,16 +5,14 @@
 #include "clock_engine.h"
 #include "hw_inputs.h"     // buttons & pots
 #include "sequencer.h"
-#include <MIDI.h>
+#include "tick_wheel.h"
+#include "midi_port.h"
 
-/* ---- exact extern declared by the FortySevenEffects library ---- */
-extern MIDI_NAMESPACE::MidiInterface<
-           MIDI_NAMESPACE::SerialMIDI<HardwareSerial>
-       > MIDI;
 using namespace MIDI_NAMESPACE;
 
 /* ───────── constants ─────────────────────────────────────────────────── */
 constexpr uint8_t PPQN      = 24;   // MIDI clocks per quarter-note
+constexpr uint8_t BAR_TICKS = 4 * PPQN;
 volatile uint8_t  pulsesPerStepISR = 6;   // was STEP_DIV const
 
 /* ───────── state shared with ISRs  ───────────────────────────────────── */
@@ -23,9 +21,14 @@ namespace {
     volatile uint8_t  extTickCtr   = 0;   // clocks inside current step
     volatile bool     extStepFlag  = false;
     volatile bool     transportRun = false;  // set by Start / Stop
+    volatile uint8_t  extTicksDue  = 0;   // clocks not yet fed to the wheel
+    volatile uint8_t  extBarTick   = 0;   // clocks into the current bar
 
     /* internal-clock path (only used in main loop) */
     uint8_t intTickCtr = 0;
+    uint8_t intBarTick = 0;
+
+    volatile uint8_t barCount = 0;        // see clock::bars()
 
     /* microsecond phase accumulator for internal clock */
     unsigned long lastIntUs = 0;
@@ -47,6 +50,8 @@ static void isrClock()
 {
     if (!clock::usingExt || !transportRun) return;
 
+    ++extTicksDue;
+    if (++extBarTick >= BAR_TICKS) { extBarTick = 0; ++barCount; }
     if (++extTickCtr >= pulsesPerStepISR) {
         raiseStepFlag();
     }
@@ -54,14 +59,18 @@ static void isrClock()
 
 static void isrStart()    // 0xFA
 {
+    /* the first Clock after Start is beat 1: it fires step and bar, and
+       every step after it is a full pulsesPerStep long               */
     transportRun = true;
-    raiseStepFlag();      // beat-1 right away
+    extTickCtr   = pulsesPerStepISR - 1;
+    extBarTick   = BAR_TICKS - 1;
 }
 static void isrContinue() { transportRun = true; }
 static void isrStop()     { 
     transportRun = false; 
     extStepFlag = false; 
-    MIDI.sendControlChange(123, 0, 1);
+    extTicksDue = 0;
+    wheel::flush();                 // queued NoteOffs out, ratchets dropped, CC 123
 }
 
 /* ───────── init ─────────────────────────────────────────────────────── */
@@ -72,6 +81,7 @@ void clock::init()
     MIDI.setHandleContinue(isrContinue);
     MIDI.setHandleStop    (isrStop);
     MIDI.begin(MIDI_CHANNEL_OMNI);
+    wheel::init();
 
     lastIntUs = micros();
 }
@@ -83,8 +93,14 @@ void clock::hardResetCounters()
     extTickCtr  = 0;
     extStepFlag = false;
     intTickCtr  = 0;
+    extBarTick  = 0;                // a restart is a bar line
+    intBarTick  = 0;
+    ++barCount;
     interrupts();
+    lastIntUs   = micros();         // no catch-up burst for the time we were off
 }
+uint8_t clock::bars() { return barCount; }
+
 void clock::forceStop()   // call if you need an emergency kill
 {
     noInterrupts();
@@ -115,16 +131,21 @@ void clock::service()
     }
 
     /* If the user flipped Ext-Sync, flush the external counters so
-       we never reuse stale ticks when we switch modes. */
+       we never reuse stale ticks when we switch modes – and the wheel,
+       whose queued offs belong to the other clock's timeline. */
     static bool prevUsingExt = usingExt;
     if (usingExt != prevUsingExt) {
         hardResetCounters();
-        lastIntUs = micros();
+        wheel::flush();
         prevUsingExt = usingExt;
     }
 
-    /* Transport OFF ⇒ everything frozen except MIDI parser in loop() */
-    if (!on) { transportRun = false; return; }
+    /* Transport OFF ⇒ everything frozen except MIDI parser in loop();
+       loop() flushes the wheel on the ON → OFF edge */
+    if (!on) {
+        transportRun = false;
+        return;
+    }
 
     /* =============================================================
        A.  External-clock branch
@@ -132,6 +153,7 @@ void clock::service()
     if (usingExt)
     {
         bool fire = false;
+        uint8_t ticks;
 
         /* grab & clear the flag with interrupts masked for 1-2 µs */
         noInterrupts();
@@ -139,9 +161,12 @@ void clock::service()
             extStepFlag = false;
             fire = true;
         }
+        ticks = extTicksDue;
+        extTicksDue = 0;
         interrupts();
 
-        if (fire && transportRun) seq::nextStep();
+        if (fire && transportRun) seq::nextStep();   // queues onto the wheel …
+        while (ticks--) wheel::tick();               // … which these ticks drain
         return;                       // no internal clock math
     }
 
@@ -157,9 +182,11 @@ void clock::service()
         lastIntUs += usPerTick;           // maintain phase
         MIDI.sendRealTime(midi::Clock);   // keep downstream gear happy
 
+        if (++intBarTick >= BAR_TICKS) { intBarTick = 0; ++barCount; }
         if (++intTickCtr >= pulsesPerStepISR) {
             intTickCtr = 0;
             seq::nextStep();
         }
+        wheel::tick();                    // due notes, step's own tick included
     }
 }
@@ -9,9 +9,13 @@ namespace clock {
     // call each loop()  – handles both ext & int timing
     void service();
 
-    void hardResetCounters();
+    void hardResetCounters();       // also starts a new bar
     void forceStop();
 
+    // bar lines (4/4, 96 clocks) passed since power-up, wrapping.  Counted
+    // from Start / transport on, so it follows the clock, not the steps.
+    uint8_t bars();
+
     // the app can read or set these (but doesn’t have to)
     extern bool     usingExt;         // true = follow external clock
     extern uint16_t bpm;              // beats per minute (30-300)
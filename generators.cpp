@@ -0,0 +1,66 @@
+/*  generators.cpp  ───────────────────────────────────────────────────────
+    Markov pitch rows + Euclidean gate masks (see generators.h)
+    ---------------------------------------------------------------------- */
+
+#include "generators.h"
+#include <avr/pgmspace.h>
+
+namespace {
+
+    /* leap preference by distance in degrees: steps and thirds first */
+    const uint8_t kLeap[8] PROGMEM = { 3, 8, 6, 4, 3, 2, 2, 1 };
+
+    uint8_t src[8]  = {0};
+    uint8_t rows[8][8];                   // rows[i][j] = P(next ≤ j | prev i) × 255
+    bool    rowsValid = false;
+
+    uint8_t  euDensity = 0xFF, euRot = 0xFF;
+    uint16_t euMask = 0;
+}
+
+void gen::markovRefresh(const uint8_t* sliders)
+{
+    if (rowsValid && !memcmp(src, sliders, sizeof src)) return;
+    memcpy(src, sliders, sizeof src);
+    rowsValid = true;
+
+    for (uint8_t i = 0; i < 8; ++i) {
+        uint16_t w[8], total = 0;
+        for (uint8_t j = 0; j < 8; ++j)
+            total += w[j] = src[j] * pgm_read_byte(&kLeap[i > j ? i - j : j - i]);
+
+        uint16_t acc = 0;
+        for (uint8_t j = 0; j < 8; ++j) {
+            acc += w[j];
+            rows[i][j] = total ? uint8_t(uint32_t(acc) * 255 / total) : 255;
+        }
+        rows[i][7] = 255;                 // every draw lands somewhere
+    }
+}
+
+/* smallest j with r < row[j], as a three-level binary search */
+uint8_t gen::markovNext(uint8_t prev, uint8_t r)
+{
+    const uint8_t* row = rows[prev & 7];
+    if (r == 255) r = 254;
+    uint8_t j = 0;
+    if (row[j + 3] <= r) j += 4;
+    if (row[j + 1] <= r) j += 2;
+    if (row[j]     <= r) j += 1;
+    return j;
+}
+
+uint16_t gen::euclid(uint8_t density, uint8_t rot)
+{
+    rot &= 15;
+    if (density == euDensity && rot == euRot) return euMask;
+    euDensity = density; euRot = rot;
+
+    uint8_t  hits = (uint16_t(density) * 17) >> 7;      // 0-16
+    uint16_t m = 0;
+    for (uint8_t s = 0; s < 16; ++s)                     // Bresenham = Bjorklund up to rotation
+        if (((s * hits) & 15) < hits) m |= uint16_t(1) << s;
+
+    euMask = rot ? uint16_t((m << rot) | (m >> (16 - rot))) : m;
+    return euMask;
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <Arduino.h>
+
+/*  generators.h  ─────────────────────────────────────────────────────────
+    Alternative lane generators, both constant-time per draw:
+      • Markov pitch – first-order, transition rows derived from the
+        eight pitch sliders (slider weight × leap preference) and cached
+        as 8-bit cumulative rows; a draw is three compares.
+      • Euclidean gates – hits spread evenly over 16 steps, rotated;
+        cached as one 16-bit mask, a draw is a shift.
+    Callers pass their own random bits so seq's bulk xorshift and
+    Arduino random() can both drive them.
+    ---------------------------------------------------------------------- */
+
+namespace gen {
+
+    enum PitchMode : uint8_t { PitchWeighted, PitchMarkov };
+    enum GateMode  : uint8_t { GateCoin,      GateEuclid  };
+
+    /* rebuilds the rows only when a slider moved */
+    void     markovRefresh(const uint8_t* sliders);
+    /* next degree after `prev` (0-7); r = any random byte            */
+    uint8_t  markovNext(uint8_t prev, uint8_t r);
+
+    /* 16-step Euclidean mask for density 0-127, rotated by rot (0-15);
+       cached until either input changes                               */
+    uint16_t euclid(uint8_t density, uint8_t rot);
+}
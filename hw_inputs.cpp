@@ -1,15 +1,22 @@
 #include "hw_inputs.h"
+#include "scales.h"
 #include <Arduino.h>
+#include <stddef.h>
 
 /* ───────────── 1. Physical pin mapping  ──────────────────── */
 constexpr uint8_t MUX_S0 = 5,  MUX_S1 = 4,  MUX_S2 = 3,  MUX_S3 = 2;
-constexpr uint8_t MUX_SIG[3] = {A5, A6, A4};
-constexpr uint8_t LED_PINS[8] = {A7, 7, 8, 9, 10, 11, 12, 13};
-static uint8_t    ledTimer[8] = {0};
-constexpr uint8_t kPpsLookup[9] = {96,72,48,32,24,18,12,9,6}; // 1, d2,2,d4,4,d8,8,d16,16
+static const uint8_t MUX_SIG[3]    PROGMEM = {A5, A6, A4};
+static const uint8_t LED_PINS[8]   PROGMEM = {A7, 7, 8, 9, 10, 11, 12, 13};
+static uint8_t       ledTimer[8]   = {0};
+static const uint8_t kPpsLookup[9] PROGMEM = {96,72,48,32,24,18,12,9,6}; // 1, d2,2,d4,4,d8,8,d16,16
+
+static inline uint8_t ledPin(uint8_t i) { return pgm_read_byte(&LED_PINS[i]); }
 
 /* ───────────── 2. Raw-input descriptor  ──────────────────── */
-struct Input { uint8_t mux, ch; bool isButton; int lastVal; bool led; int8_t ledIdx; };
+/* one flash byte per input: mux (bits 4-5), channel (0-3), button (6).
+   Only the reading is mutable and lives in RAM (lastVal[] below).     */
+#define QM_IN(mux, ch, btn)  uint8_t((mux) << 4 | (ch) | ((btn) ? 0x40 : 0))
+constexpr uint8_t IN_BTN = 0x40;
 
 /* ───────────── 3. Symbolic indexes  (shortened) ──────────── */
 enum InIdx {
@@ -27,53 +34,58 @@ enum InIdx {
 
 
 /* ───────────── 4. Physical lookup table  (abbrev) ────────── */
-Input inputs[N_RAW_INPUTS] = {
+static const uint8_t kInput[N_RAW_INPUTS] PROGMEM = {
   //MUX0
-  {0,0 ,false,-1,false,-1}, //IDX_LOOP_END
-  {0,3 ,false,-1,false,-1}, //IDX_DESTRUCT_POT
-  {0,4 ,true ,-1,false,-1}, //IDX_BTN_DESTRUCT ***A7 LED MISTAKE***
-  {0,5 ,true ,-1,false, 3}, //IDX_BTN_CYC_L
-  {0,6 ,false,-1,false,-1}, //IDX_SLIDE_8
-  {0,7 ,false,-1,false,-1}, //IDX_SLIDE_7
-  {0,8 ,false,-1,false,-1}, //IDX_SLIDE_6
-  {0,9 ,false,-1,false,-1}, //IDX_SLIDE_5
-  {0,10,false,-1,false,-1}, //IDX_SLIDE_4
-  {0,11,false,-1,false,-1}, //IDX_OCT_4
-  {0,12,false,-1,false,-1}, //IDX_OCT_5
-  {0,13,false,-1,false,-1}, //IDX_OCT_6
-  {0,14,false,-1,false,-1}, //IDX_OCT_7
-  {0,15,false,-1,false,-1}, //IDX_OCT_8
+  QM_IN(0,0 ,false), //IDX_LOOP_END
+  QM_IN(0,3 ,false), //IDX_DESTRUCT_POT
+  QM_IN(0,4 ,true ), //IDX_BTN_DESTRUCT ***A7 LED MISTAKE***
+  QM_IN(0,5 ,true ), //IDX_BTN_CYC_L
+  QM_IN(0,6 ,false), //IDX_SLIDE_8
+  QM_IN(0,7 ,false), //IDX_SLIDE_7
+  QM_IN(0,8 ,false), //IDX_SLIDE_6
+  QM_IN(0,9 ,false), //IDX_SLIDE_5
+  QM_IN(0,10,false), //IDX_SLIDE_4
+  QM_IN(0,11,false), //IDX_OCT_4
+  QM_IN(0,12,false), //IDX_OCT_5
+  QM_IN(0,13,false), //IDX_OCT_6
+  QM_IN(0,14,false), //IDX_OCT_7
+  QM_IN(0,15,false), //IDX_OCT_8
 
   //MUX1
-  {1,0 ,false,-1,false,-1}, //IDX_OCT_3
-  {1,1 ,false,-1,false,-1}, //IDX_OCT_2
-  {1,2 ,false,-1,false,-1}, //IDX_OCT_1
-  {1,3 ,false,-1,false,-1}, //IDX_SLIDE_3
-  {1,4 ,false,-1,false,-1}, //IDX_SLIDE_2
-  {1,5 ,false,-1,false,-1}, //IDX_SLIDE_1
-  {1,6 ,false,-1,false,-1}, //IDX_ACC_PROB_POT
-  {1,7 ,false,-1,false,-1}, //IDX_ACC_AMT_POT
-  {1,8 ,false,-1,false,-1}, //IDX_DENSITY_POT
-  {1,9 ,false,-1,false,-1}, //IDX_SCALE_POT
-  {1,10,false,-1,false,-1}, //IDX_VELOCITY_POT
-  {1,11,false,-1,false,-1}, //IDX_TEMPO_POT
-  {1,12,false,-1,false,-1}, //IDX_ROOT_POT
-  {1,13,true ,-1,false, 6}, //IDX_BTN_ONOFF_TOG
-  {1,14,true ,-1,false, 7}, //IDX_BTN_EXTMIDI_TOG
-  {1,15,false,-1,false,-1}, //IDX_LOOP_START
+  QM_IN(1,0 ,false), //IDX_OCT_3
+  QM_IN(1,1 ,false), //IDX_OCT_2
+  QM_IN(1,2 ,false), //IDX_OCT_1
+  QM_IN(1,3 ,false), //IDX_SLIDE_3
+  QM_IN(1,4 ,false), //IDX_SLIDE_2
+  QM_IN(1,5 ,false), //IDX_SLIDE_1
+  QM_IN(1,6 ,false), //IDX_ACC_PROB_POT
+  QM_IN(1,7 ,false), //IDX_ACC_AMT_POT
+  QM_IN(1,8 ,false), //IDX_DENSITY_POT
+  QM_IN(1,9 ,false), //IDX_SCALE_POT
+  QM_IN(1,10,false), //IDX_VELOCITY_POT
+  QM_IN(1,11,false), //IDX_TEMPO_POT
+  QM_IN(1,12,false), //IDX_ROOT_POT
+  QM_IN(1,13,true ), //IDX_BTN_ONOFF_TOG
+  QM_IN(1,14,true ), //IDX_BTN_EXTMIDI_TOG
+  QM_IN(1,15,false), //IDX_LOOP_START
 
   //MUX2
-  {2,0 ,false,-1,false,-1}, //IDX_DELTA_PITCH
-  {2,2 ,false,-1,false,-1}, //IDX_DELTA_VEL
-  {2,4 ,false,-1,false,-1}, //IDX_DELTA_OCT
-  {2,6 ,false,-1,false,-1}, //IDX_DELTA_ACC
-  {2,8 ,true ,-1,false, 5}, //IDX_BTN_CYC_R
-  {2,9 ,true ,-1,false,-1}, // IDX_BTN_RESET   (should be 4 on a working pcb)
-  {2,10,true ,-1,false, 2}, //IDX_BTN_INST
-  {2,11,true ,-1,false, 1}, //IDX_BTN_NONDEST
-  {2,14,false,-1,false,-1}, //IDX_INST_POT
-  {2,15,false,-1,false,-1}  //IDX_NONDEST_POT
+  QM_IN(2,0 ,false), //IDX_DELTA_PITCH
+  QM_IN(2,2 ,false), //IDX_DELTA_VEL
+  QM_IN(2,4 ,false), //IDX_DELTA_OCT
+  QM_IN(2,6 ,false), //IDX_DELTA_ACC
+  QM_IN(2,8 ,true ), //IDX_BTN_CYC_R
+  QM_IN(2,9 ,true ), // IDX_BTN_RESET   (should be 4 on a working pcb)
+  QM_IN(2,10,true ), //IDX_BTN_INST
+  QM_IN(2,11,true ), //IDX_BTN_NONDEST
+  QM_IN(2,14,false), //IDX_INST_POT
+  QM_IN(2,15,false)   //IDX_NONDEST_POT
 };
+#undef QM_IN
+
+/* pots: last accepted 10-bit reading.  Buttons keep their state in the
+   btnDown / btnLatch bit masks instead.                               */
+static uint16_t lastVal[N_RAW_INPUTS];
 
 /* ───────────── 5. Public globals ------------------------------------ */
 namespace hw {
@@ -83,26 +95,271 @@ namespace hw {
                  btnCycleL,  btnCycleR,  btnReset;
 }
 
+/* ───────────── 5-B. Button table + event ring ---------------------- */
+struct BtnSlot { uint8_t in; bool toggle; int8_t flashLed; int8_t latchLed; };
+
+static const BtnSlot kBtn[(uint8_t)hw::Btn::Count] PROGMEM = {   // order = hw::Btn
+  {IDX_BTN_ONOFF_TOG  , true , -1,  6},
+  {IDX_BTN_EXTMIDI_TOG, true , -1,  7},
+  {IDX_BTN_DESTRUCT   , true , -1, -1},
+  {IDX_BTN_INST       , false,  2, -1},
+  {IDX_BTN_NONDEST    , false,  1, -1},
+  {IDX_BTN_CYC_L      , false,  3, -1},
+  {IDX_BTN_CYC_R      , false,  5, -1},
+  {IDX_BTN_RESET      , false,  4, -1},
+};
+static_assert((uint8_t)hw::Btn::Count <= 8, "button state is one bit per button");
+static uint8_t btnDown  = 0;            // debounced level, bit per hw::Btn
+static uint8_t btnLatch = 0;            // toggle latches, bit per hw::Btn
+
+static hw::ButtonState* const kBtnState[(uint8_t)hw::Btn::Count] PROGMEM = {
+  &hw::btnOnOff, &hw::btnExtMidi, &hw::btnDestruct, &hw::btnInstant,
+  &hw::btnCopy,  &hw::btnCycleL,  &hw::btnCycleR,   &hw::btnReset
+};
+
+constexpr uint8_t  DEBOUNCE_MS = 8;     // ignore chatter inside this window
+constexpr uint8_t  EVQ_SIZE    = 16;    // power of two
+static_assert(EVQ_SIZE >= 2 * (uint8_t)hw::Btn::Count, "two full scans between drains");
+static hw::BtnEvent evq[EVQ_SIZE];
+static uint8_t      evHead = 0;         // free-running write index
+static uint16_t     btnLastMs[(uint8_t)hw::Btn::Count] = {0};
+
+static inline void pushEvent(hw::Btn b, bool press, uint16_t ms)
+{
+    evq[evHead & (EVQ_SIZE - 1)] = { b, press, ms };
+    ++evHead;
+}
+
+bool hw::nextEvent(EventReader& r, BtnEvent& out)
+{
+    if (r.tail == evHead) return false;
+    uint8_t behind = evHead - r.tail;
+    if (behind > EVQ_SIZE) {                      // reader fell a whole ring behind
+        uint8_t n = behind - EVQ_SIZE;
+        r.lost = r.lost > 255 - n ? 255 : r.lost + n;
+        r.tail = evHead - EVQ_SIZE;
+    }
+    out = evq[r.tail & (EVQ_SIZE - 1)];
+    ++r.tail;
+    return true;
+}
+
+/* pots that crossed the hysteresis since the last mapping pass.  Only
+   those overwrite PotValues, so a value set elsewhere (SysEx load)
+   sticks until the physical control is actually turned.               */
+static uint8_t movedBits[(N_RAW_INPUTS + 7) / 8];
+
+/* ───────────── 5-C. Parameter table  (order = hw::Param) ──────────── */
+struct ParamDesc { uint8_t in; uint8_t off; int16_t lo, hi; };   // map(raw, 0,1024, lo,hi)
+constexpr uint8_t NO_POT = 0xFF;                                 // remote-only field
+
+#define QM_F(f)     uint8_t(offsetof(hw::PotValues, f))
+#define QM_FA(f, i) uint8_t(offsetof(hw::PotValues, f) + (i))
+static const ParamDesc kParam[(uint8_t)hw::Param::Count] PROGMEM = {
+  {IDX_SLIDE_1     , QM_FA(pitchProb , 0), 127, -1},
+  {IDX_SLIDE_2     , QM_FA(pitchProb , 1), 127, -1},
+  {IDX_SLIDE_3     , QM_FA(pitchProb , 2), 127, -1},
+  {IDX_SLIDE_4     , QM_FA(pitchProb , 3), 127, -1},
+  {IDX_SLIDE_5     , QM_FA(pitchProb , 4), 127, -1},
+  {IDX_SLIDE_6     , QM_FA(pitchProb , 5), 127, -1},
+  {IDX_SLIDE_7     , QM_FA(pitchProb , 6), 127, -1},
+  {IDX_SLIDE_8     , QM_FA(pitchProb , 7), 127, -1},
+  {IDX_OCT_1       , QM_FA(octaveProb, 0),   0, 128},
+  {IDX_OCT_2       , QM_FA(octaveProb, 1),   0, 128},
+  {IDX_OCT_3       , QM_FA(octaveProb, 2),   0, 128},
+  {IDX_OCT_4       , QM_FA(octaveProb, 3),   0, 128},
+  {IDX_OCT_5       , QM_FA(octaveProb, 4),   0, 128},
+  {IDX_OCT_6       , QM_FA(octaveProb, 5),   0, 128},
+  {IDX_OCT_7       , QM_FA(octaveProb, 6),   0, 128},
+  {IDX_OCT_8       , QM_FA(octaveProb, 7),   0, 128},
+  {IDX_DELTA_PITCH , QM_FA(deltaProb , 0), 127, -1},
+  {IDX_DELTA_VEL   , QM_FA(deltaProb , 1), 127, -1},
+  {IDX_DELTA_OCT   , QM_FA(deltaProb , 2), 127, -1},
+  {IDX_DELTA_ACC   , QM_FA(deltaProb , 3), 127, -1},
+  {IDX_DENSITY_POT , QM_F(density),          0, 128},
+  {IDX_DESTRUCT_POT, QM_F(destructiveChance),0, 128},
+  {IDX_NONDEST_POT , QM_F(nondestChance),    0, 128},
+  {IDX_INST_POT    , QM_F(instChance),       0, 128},
+  {IDX_ACC_PROB_POT, QM_F(accentChance),     0, 128},
+  {IDX_TEMPO_POT   , QM_F(bpm),              3, 303},     // 16-bit, + pulsesPerStep
+  {IDX_LOOP_START  , QM_F(loopStart),        1, 17},
+  {IDX_LOOP_END    , QM_F(loopEnd),          1, 17},
+  {IDX_ROOT_POT    , QM_F(root),             0, 128},
+  {IDX_VELOCITY_POT, QM_F(velocity),         0, 128},
+  {IDX_ACC_AMT_POT , QM_F(accentVel),        0, 128},
+  {IDX_SCALE_POT   , QM_F(scale),            1, scale::Count + 1},
+  {NO_POT          , QM_F(swing),            0, 128},
+  {NO_POT          , QM_F(nudge),            0, 128},
+  {NO_POT          , QM_F(ratchetChance),    0, 128},
+  {NO_POT          , QM_F(chordChance),      0, 128},
+  {NO_POT          , QM_F(pitchGen),         0, 2},
+  {NO_POT          , QM_F(gateGen),          0, 2},
+  {NO_POT          , QM_F(euclidRot),        0, 16},
+  {NO_POT          , QM_F(quantRotate),      0, 4},      // seq::Quant
+  {NO_POT          , QM_F(quantCommit),      0, 4},
+  {NO_POT          , QM_F(quantInstant),     0, 4},
+  {NO_POT          , QM_F(quantReset),       0, 4},
+  {NO_POT          , QM_F(chainMode),        0, 2},
+  {NO_POT          , QM_F(keyChannel),       0, 17},     // key follow
+  {NO_POT          , QM_F(keyScale),         0, 2},
+  {NO_POT          , QM_F(keyRepitch),       0, 2},
+  {NO_POT          , QM_F(ccChannel),        1, 17},     // cc_map
+};
+#undef QM_F
+#undef QM_FA
+
+constexpr uint8_t N_PARAMS = (uint8_t)hw::Param::Count;
+static uint8_t heldBits[(N_PARAMS + 7) / 8];     // remote value wins until picked up
+static uint8_t sideBits[(N_PARAMS + 7) / 8];     // pot sat above the held value
+
+static inline bool test(const uint8_t* b, uint8_t p) { return b[p >> 3] & (1 << (p & 7)); }
+
+static int16_t readParam(uint8_t p, const ParamDesc& d)
+{
+    uint8_t* f = reinterpret_cast<uint8_t*>(&hw::pots) + d.off;
+    return p == (uint8_t)hw::Param::Tempo ? int16_t(hw::pots.bpm) : int16_t(*f);
+}
+
+static inline int16_t potValue(const ParamDesc& d)
+{
+    return map(lastVal[d.in], 0,1024, d.lo, d.hi);
+}
+
+/* hold a field at its new value and note which side of it the pot is
+   on right now – the pot takes over once it crosses to the other side */
+static void hold(uint8_t p, const ParamDesc& d)
+{
+    uint8_t bit = 1 << (p & 7);
+    heldBits[p >> 3] |= bit;
+    if (d.in != NO_POT && potValue(d) > readParam(p, d)) sideBits[p >> 3] |=  bit;
+    else                                                 sideBits[p >> 3] &= ~bit;
+}
+
+/* the field's own min / max – the pot rows run hi-exclusive, and the
+   slider / delta rows run backwards (lo 127, hi -1)                  */
+static inline int16_t fieldMin(const ParamDesc& d) { return d.lo < d.hi ? d.lo : d.hi + 1; }
+static inline int16_t fieldMax(const ParamDesc& d) { return d.lo < d.hi ? d.hi - 1 : d.lo; }
+
+static void writeParam(uint8_t p, const ParamDesc& d, int16_t v)
+{
+    if (p == (uint8_t)hw::Param::Tempo) {
+        hw::pots.bpm = v;
+        uint8_t ix = map(v, 3,304, 0,9);                  // 0-8
+        hw::pots.pulsesPerStep = pgm_read_byte(&kPpsLookup[ix]);
+        return;
+    }
+    *(reinterpret_cast<uint8_t*>(&hw::pots) + d.off) = uint8_t(v);
+}
+
+/* pot path: only writes when not held, or when the pot has caught up */
+static void potParam(uint8_t p, int16_t v)
+{
+    ParamDesc d;
+    memcpy_P(&d, &kParam[p], sizeof d);
+    if (test(heldBits, p)) {
+        int16_t span = d.hi > d.lo ? d.hi - d.lo : d.lo - d.hi;
+        int16_t tol  = span / 32 + 1;
+        int16_t held = readParam(p, d);
+        /* picked up when the pot lands in the window or crosses the held
+           value – a fast sweep can jump the window between two scans  */
+        if (abs(v - held) > tol && (v > held) == test(sideBits, p)) return;
+        heldBits[p >> 3] &= ~(1 << (p & 7));
+    }
+    writeParam(p, d, v);
+}
+
+void hw::setParam(Param p, uint8_t v7)
+{
+    uint8_t i = (uint8_t)p;
+    if (i >= N_PARAMS) return;
+    ParamDesc d;
+    memcpy_P(&d, &kParam[i], sizeof d);
+    writeParam(i, d, map(v7 & 0x7F, 0,127, fieldMin(d), fieldMax(d)));   // 0 = min, 127 = max
+    hold(i, d);
+}
+
+void hw::setParamValue(Param p, int16_t v)
+{
+    uint8_t i = (uint8_t)p;
+    if (i >= N_PARAMS) return;
+    ParamDesc d;
+    memcpy_P(&d, &kParam[i], sizeof d);
+    v = constrain(v, fieldMin(d), fieldMax(d));
+    writeParam(i, d, v);
+    hold(i, d);
+}
+
+void hw::holdAll()
+{
+    for (uint8_t p = 0; p < N_PARAMS; ++p) {
+        ParamDesc d;
+        memcpy_P(&d, &kParam[p], sizeof d);
+        hold(p, d);
+    }
+}
+
+void hw::releaseAll() { memset(heldBits, 0, sizeof heldBits); }
+
 /* ───────────── 6. Internal helpers  ───────────────────────────────── */
-static inline int readMux(uint8_t m,uint8_t ch){
-    digitalWrite(MUX_S0, bitRead(ch,0));
-    digitalWrite(MUX_S1, bitRead(ch,1));
-    digitalWrite(MUX_S2, bitRead(ch,2));
-    digitalWrite(MUX_S3, bitRead(ch,3));
+static inline int readMux(uint8_t in){
+    uint8_t d = pgm_read_byte(&kInput[in]);
+    digitalWrite(MUX_S0, bitRead(d,0));
+    digitalWrite(MUX_S1, bitRead(d,1));
+    digitalWrite(MUX_S2, bitRead(d,2));
+    digitalWrite(MUX_S3, bitRead(d,3));
     delayMicroseconds(4);
-    return analogRead(MUX_SIG[m]);
+    return analogRead(pgm_read_byte(&MUX_SIG[(d >> 4) & 0x03]));
 }
 
 /* ───────────── 7. initPins()  ─────────────────────────────────────── */
 void hw::initPins(){
     pinMode(MUX_S0,OUTPUT); pinMode(MUX_S1,OUTPUT);
     pinMode(MUX_S2,OUTPUT); pinMode(MUX_S3,OUTPUT);
-    for(uint8_t p:LED_PINS){ pinMode(p,OUTPUT); digitalWrite(p,LOW); }
+    for(uint8_t i=0;i<8;i++){ pinMode(ledPin(i),OUTPUT); digitalWrite(ledPin(i),LOW); }
+    memset(movedBits, 0xFF, sizeof movedBits);     // first pass maps every pot
+}
+
+/* ───────────── 8-A. fast path: every button, every call ──────────── */
+static void scanButtons()
+{
+    uint16_t ms = millis();
+
+    for (uint8_t b = 0; b < (uint8_t)hw::Btn::Count; ++b) {
+        BtnSlot k;
+        memcpy_P(&k, &kBtn[b], sizeof k);
+        uint8_t bit = 1 << b;
+
+        bool pressed = readMux(k.in) > 512;
+        if (pressed == bool(btnDown & bit)) continue;              // no change
+        if (uint16_t(ms - btnLastMs[b]) < DEBOUNCE_MS) continue;  // bounce
+        btnLastMs[b] = ms;
+        btnDown ^= bit;
+
+        if (pressed) {
+            if (k.toggle) {                                       // latch
+                btnLatch ^= bit;
+                if (k.latchLed >= 0) digitalWrite(ledPin(k.latchLed), (btnLatch & bit) ? HIGH : LOW);
+            }
+            if (k.flashLed >= 0) {
+                ledTimer[k.flashLed] = 4;
+                digitalWrite(ledPin(k.flashLed), HIGH);
+            }
+        }
+        auto* st = static_cast<hw::ButtonState*>(pgm_read_ptr(&kBtnState[b]));
+        st->level = k.toggle ? bool(btnLatch & bit) : pressed;
+        pushEvent(hw::Btn(b), pressed, ms);
+    }
+
+    /* tie Destructive ON to reset-LED ---------------------------- */
+    digitalWrite(ledPin(4), hw::btnDestruct.level ? HIGH : LOW);   //  LED 5
 }
 
 /* ───────────── 8. scanInputs()  ───────────────────────────────────── */
 void hw::scanInputs()
 {
+    /* buttons never wait behind the pot rotation */
+    scanButtons();
+
     /* 0. decide which slice of the big table we will touch this round */
     static uint8_t bank = 0;               // 0 → first ⅓, 1 → second ⅓, 2 → last ⅓
     constexpr uint8_t BANKS      = 3;
@@ -112,126 +369,35 @@ void hw::scanInputs()
              ? start + BANK_SIZE
              : N_RAW_INPUTS;
 
-    /* 1. read ONLY that slice (analogRead + button debounce) */
+    /* 1. read ONLY the pots of that slice – buttons were done above */
     for (uint16_t i = start; i < end; ++i) {
-        int v = readMux(inputs[i].mux, inputs[i].ch);
-
-        if (inputs[i].isButton) {
-            bool pressed = (v > 512);
-            if (pressed && inputs[i].lastVal == 0) {           // rising edge
-                inputs[i].led = !inputs[i].led;
-                if (inputs[i].ledIdx >= 0)
-                    digitalWrite(LED_PINS[inputs[i].ledIdx], inputs[i].led);
-            }
-            inputs[i].lastVal = pressed;
-        } else {
-            if (abs(v - inputs[i].lastVal) > 10)
-                inputs[i].lastVal = v;
+        if (pgm_read_byte(&kInput[i]) & IN_BTN) continue;
+        int v = readMux(i);
+        if (abs(v - int(lastVal[i])) > 10) {
+            lastVal[i] = v;
+            movedBits[i >> 3] |= 1 << (i & 7);
         }
     }
 
     /* 2. advance bank pointer for next loop() pass */
     bank = (bank + 1) % BANKS;
 
-    /* 3. *Only after we have read ALL 3 slices* do we rebuild Pots & Buttons. */
+    /* 3. *Only after we have read ALL 3 slices* do we rebuild Pots. */
     if (bank != 0) return;                // not finished yet → skip the mapping step
+    /* 8-B  map raw pots that moved into PotValues (table-driven) ---- */
+    for (uint8_t p = 0; p < N_PARAMS; ++p) {
+        uint8_t in = pgm_read_byte(&kParam[p].in);
+        if (in == NO_POT) continue;
+        if (!(movedBits[in >> 3] & (1 << (in & 7)))) continue;
+        int16_t lo = pgm_read_word(&kParam[p].lo), hi = pgm_read_word(&kParam[p].hi);
+        potParam(p, map(lastVal[in], 0,1024, lo, hi));
+    }
 
-    /* 8-B  map raw pots to 0-100/127/…, fill PotValues -------------- */
-    auto pot = [&](InIdx idx){ return inputs[idx].lastVal; };
-
-    pots.pitchProb[0]          = map(pot(IDX_SLIDE_1), 0,1024,127,-1);
-    pots.pitchProb[1]          = map(pot(IDX_SLIDE_2), 0,1024,127,-1);
-    pots.pitchProb[2]          = map(pot(IDX_SLIDE_3), 0,1024,127,-1);
-    pots.pitchProb[3]          = map(pot(IDX_SLIDE_4), 0,1024,127,-1);
-    pots.pitchProb[4]          = map(pot(IDX_SLIDE_5), 0,1024,127,-1);
-    pots.pitchProb[5]          = map(pot(IDX_SLIDE_6), 0,1024,127,-1);
-    pots.pitchProb[6]          = map(pot(IDX_SLIDE_7), 0,1024,127,-1);
-    pots.pitchProb[7]          = map(pot(IDX_SLIDE_8), 0,1024,127,-1);
-
-    pots.octaveProb[0]         = map(pot(IDX_OCT_1),   0,1024, 0, 128);
-    pots.octaveProb[1]         = map(pot(IDX_OCT_2),   0,1024, 0, 128);
-    pots.octaveProb[2]         = map(pot(IDX_OCT_3),   0,1024, 0, 128);
-    pots.octaveProb[3]         = map(pot(IDX_OCT_4),   0,1024, 0, 128);
-    pots.octaveProb[4]         = map(pot(IDX_OCT_5),   0,1024, 0, 128);
-    pots.octaveProb[5]         = map(pot(IDX_OCT_6),   0,1024, 0, 128);
-    pots.octaveProb[6]         = map(pot(IDX_OCT_7),   0,1024, 0, 128);
-    pots.octaveProb[7]         = map(pot(IDX_OCT_8),   0,1024, 0, 128);
-
-    pots.density               = map(pot(IDX_DENSITY_POT), 0,1024, 0, 128);
-
-    pots.deltaProb[0]          = map(pot(IDX_DELTA_PITCH), 0,1024, 127,-1);
-    pots.deltaProb[1]          = map(pot(IDX_DELTA_VEL  ), 0,1024, 127,-1);
-    pots.deltaProb[2]          = map(pot(IDX_DELTA_OCT  ), 0,1024, 127,-1);
-    pots.deltaProb[3]          = map(pot(IDX_DELTA_ACC  ), 0,1024, 127,-1);
-
-    pots.destructiveChance     = map(pot(IDX_DESTRUCT_POT), 0,1024, 0,128);
-    pots.nondestChance         = map(pot(IDX_NONDEST_POT ), 0,1024, 0,128);
-    pots.instChance            = map(pot(IDX_INST_POT    ), 0,1024, 0,128);
-    pots.accentChance          = map(pot(IDX_ACC_PROB_POT ), 0,1024, 0,128);
-
-    pots.bpm                   = map(pot(IDX_TEMPO_POT   ), 0,1023, 3,303);
-    uint8_t ix = map(pot(IDX_TEMPO_POT), 0,1024, 0,9);   // 0-8
-    pots.pulsesPerStep = kPpsLookup[ix];
-
-    pots.loopStart             = map(pot(IDX_LOOP_START  ), 0,1024, 1, 17);
-    pots.loopEnd               = map(pot(IDX_LOOP_END    ), 0,1024, 1, 17);
-    pots.root                  = map(pot(IDX_ROOT_POT    ), 0,1024, 0,128);
-    pots.velocity              = map(pot(IDX_VELOCITY_POT), 0,1024, 0,128);
-    pots.accentVel             = map(pot(IDX_ACC_AMT_POT ), 0,1024, 0,128);
-    pots.scale                 = map(pot(IDX_SCALE_POT   ), 0,1024, 1,  8);
-
-
-    /* 8-C  buttons: level + edge ----------------------------------- */
-    auto mapBtn = [&](ButtonState& b, InIdx idx){
-        bool now = inputs[idx].lastVal;
-        b.edge  = now && !b.level;
-        b.level = now;
-    };
-
-    auto mapTgl = [&](ButtonState& b, InIdx idx){
-        bool now = inputs[idx].led;         // latched ON / OFF
-        b.edge  = now && !b.level;          // edge when it turns ON
-        b.level = now;
-    };
-
-    mapTgl(btnOnOff    , IDX_BTN_ONOFF_TOG  );
-    mapTgl(btnDestruct , IDX_BTN_DESTRUCT   );
-    mapTgl(btnExtMidi  , IDX_BTN_EXTMIDI_TOG);
-
-    mapBtn(btnInstant  , IDX_BTN_INST       );
-    /*if (btnInstant.edge) {
-        static unsigned long lastEdgeMs = 0;
-        unsigned long now = millis();
-        if (now - lastEdgeMs < 30) {      // 30-ms window → kill bounce
-            btnInstant.edge = false;      // ignore this spurious edge
-        } else {
-            lastEdgeMs = now;             // accept, remember time
-        }
-    }*/
-
-    mapBtn(btnCopy     , IDX_BTN_NONDEST    );
-
-    mapBtn(btnCycleL   , IDX_BTN_CYC_L      );
-    mapBtn(btnCycleR   , IDX_BTN_CYC_R      );
-    mapBtn(btnReset    , IDX_BTN_RESET      );
-
-    auto flash = [&](uint8_t idx, uint8_t dur=4){
-    if(idx < 8){ ledTimer[idx] = dur;
-                 digitalWrite(LED_PINS[idx], HIGH); }
-    };
-
-    if(btnCycleL.edge) flash(3);
-    if(btnCycleR.edge) flash(5);
-    if(btnReset .edge) flash(4);
-    if(btnInstant.edge)flash(2);
-    if(btnCopy  .edge) flash(1);
-
-    /* 8-D  tie Destructive ON to reset-LED ---------------------- */
-    digitalWrite(LED_PINS[4], btnDestruct.level ? HIGH : LOW);   //  LED 5
+    memset(movedBits, 0, sizeof movedBits);
 
-    // run-down the timers
+    // run-down the flash timers
     for(uint8_t i=0;i<8;i++){
-    if(ledTimer[i] && --ledTimer[i]==0)
-        digitalWrite(LED_PINS[i], LOW);
-}
+        if(ledTimer[i] && --ledTimer[i]==0)
+            digitalWrite(ledPin(i), LOW);
+    }
 }
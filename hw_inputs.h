@@ -20,16 +20,80 @@ struct PotValues {
   uint8_t  root;
   uint8_t  velocity;
   uint8_t  accentVel;
-  uint8_t  scale;
+  uint8_t  scale;         // 1-based scale::Id
   uint8_t  pulsesPerStep; // how many MIDI clocks per sequencer step
+  uint8_t  swing;         // 0-127 → odd steps late by up to half a step
+  uint8_t  nudge;         // 0-127 → depth of the per-step micro-offset
+  uint8_t  ratchetChance; // 0-127 → chance a generated step repeats 2-4×
+  uint8_t  chordChance;   // 0-127 → chance a generated step is a chord
+  uint8_t  pitchGen;      // gen::PitchMode – weighted / Markov
+  uint8_t  gateGen;       // gen::GateMode  – density coin / Euclidean
+  uint8_t  euclidRot;     // 0-15, Euclidean rotation
+  uint8_t  quantRotate;   // seq::Quant for Cycle L / R
+  uint8_t  quantCommit;   //   … Copy (commit)
+  uint8_t  quantInstant;  //   … Instant
+  uint8_t  quantReset;    //   … Reset
+  uint8_t  chainMode;     // 0 = off, 1 = song / chain mode runs
+  uint8_t  keyChannel;    // key follow: 1-16, 0 = off
+  uint8_t  keyScale;      //   … 1 = a third over the held root sets the mode
+  uint8_t  keyRepitch;    //   … 1 = also move the note sounding now
+  uint8_t  ccChannel;     // MIDI CC remote control listens here, 1-16
 };
 
-struct ButtonState { bool level; bool edge; };
+/* ── parameter store ─────────────────────────────────────────────
+   Every PotValues field has one Param id.  Pots, MIDI CC and SysEx all
+   write through the same table.  A remote write holds the field: the
+   physical pot is ignored until it is turned to within a few counts
+   of the held value or across it (soft takeover), then it owns the
+   field again.                                                      */
+enum class Param : uint8_t {
+    PitchProb0, PitchProb7 = PitchProb0 + 7,
+    OctProb0,   OctProb7   = OctProb0 + 7,
+    DeltaPitch, DeltaVel, DeltaOct, DeltaAcc,
+    Density, Destructive, Nondest, Instant, AccentChance,
+    Tempo,                              // bpm + pulsesPerStep
+    LoopStart, LoopEnd, Root, Velocity, AccentVel, Scale,
+    Swing, Nudge, Ratchet, Chord,       // no pot – CC / SysEx only
+    PitchGen, GateGen, EuclidRot,
+    QuantRotate, QuantCommit, QuantInstant, QuantReset,
+    Chain,
+    KeyChannel, KeyScale, KeyRepitch,
+    CcChannel,
+    Count
+};
+
+void setParam(Param p, uint8_t v7);     // remote write, 0-127 → field min-max
+void setParamValue(Param p, int16_t v); // remote write in the field's own units
+void holdAll();                         // every field held (after a SysEx load)
+void releaseAll();                      // every pot owns its field again
+
+struct ButtonState { bool level; };     // edges come from the event queue
 
 extern PotValues pots;
 extern ButtonState btnOnOff, btnExtMidi, btnDestruct, btnInstant,
                    btnCopy,  btnCycleL,  btnCycleR,   btnReset;
 
+/* ── button events ───────────────────────────────────────────────
+   Buttons are scanned on every scanInputs() call and each debounced
+   press / release lands in a small ring.  Every subscriber owns an
+   EventReader and sees each event exactly once, independent of the
+   others.  Toggles report the raw press; .level holds the latch.
+   Subscribers drain once per loop() pass, which the ring covers with
+   room to spare; a reader that still falls a whole ring behind skips
+   to the oldest event kept and counts what it missed in .lost.     */
+enum class Btn : uint8_t {
+    OnOff, ExtMidi, Destruct, Instant, Copy, CycleL, CycleR, Reset, Count
+};
+
+struct BtnEvent { Btn btn; bool press; uint16_t ms; };   // ms = millis() & 0xFFFF
+
+struct EventReader {                                     // one per subscriber
+    uint8_t tail = 0;
+    uint8_t lost = 0;                                    // events overwritten unread (saturating)
+};
+
+bool nextEvent(EventReader& r, BtnEvent& out);           // false ⇒ drained
+
 void initPins();        // call once in setup()
 void scanInputs();      // call each loop()
 
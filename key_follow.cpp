@@ -0,0 +1,58 @@
+/*  key_follow.cpp  ───────────────────────────────────────────────────────
+    NoteOn → root / scale, fixed cost, no loops (see key_follow.h)
+    ---------------------------------------------------------------------- */
+
+#include "key_follow.h"
+#include "hw_inputs.h"
+#include "sequencer.h"
+#include "scales.h"
+#include "midi_port.h"
+
+namespace {
+
+    uint8_t held   = 0;           // keys down on the key channel (saturating)
+    uint8_t heldCh = 0;           // channel `held` was counted on
+
+    /* the key channel, from the Param; a new channel starts with no keys held */
+    inline uint8_t keyChannel()
+    {
+        uint8_t ch = hw::pots.keyChannel;
+        if (ch != heldCh) { heldCh = ch; held = 0; }
+        return ch;
+    }
+
+    void onNoteOff(midi::Channel ch, midi::DataByte, midi::DataByte)
+    {
+        if (ch == keyChannel() && held) --held;
+    }
+
+    void onNoteOn(midi::Channel ch, midi::DataByte note, midi::DataByte vel)
+    {
+        if (ch != keyChannel()) return;
+        if (!vel) { onNoteOff(ch, note, vel); return; }        // running-status off
+
+        /* with a root already held, a minor / major third only sets the mode */
+        uint8_t iv = (note + 12 - hw::pots.root % 12) % 12;
+        if (hw::pots.keyScale && held && (iv == 3 || iv == 4))
+            hw::setParamValue(hw::Param::Scale,
+                              (iv == 3 ? scale::Aeolian : scale::Ionian) + 1);
+        else
+            hw::setParamValue(hw::Param::Root, note);
+
+        if (held < 255) ++held;
+        if (hw::pots.keyRepitch) seq::repitch();
+    }
+}
+
+void key::init()
+{
+    setChannel(15);                       // remote-only Params, no pot to seed them
+    setRepitch(true);
+    MIDI.setHandleNoteOn (onNoteOn);
+    MIDI.setHandleNoteOff(onNoteOff);
+}
+
+void key::setChannel(uint8_t ch)   { if (ch <= 16) hw::pots.keyChannel = ch; }
+uint8_t key::channel()             { return keyChannel(); }
+void key::setFollowScale(bool on)  { hw::pots.keyScale   = on; }
+void key::setRepitch(bool on)      { hw::pots.keyRepitch = on; }
@@ -0,0 +1,21 @@
+#pragma once
+#include <Arduino.h>
+
+/*  key_follow.h  ─────────────────────────────────────────────────────────
+    Live transpose from a keyboard: NoteOn on the key channel sets the
+    root (and, with scale follow on, a third played over the held root
+    picks major / minor).  Runs inside the MIDI parser callback, so the
+    very next note nextStep() emits is already in the new key.
+    The settings are hw::Params (KeyChannel / KeyScale / KeyRepitch), so
+    CC and SysEx reach them; the setters below write the same fields.
+    ---------------------------------------------------------------------- */
+
+namespace key {
+
+    void    init();                        // hook NoteOn / NoteOff
+    void    setChannel(uint8_t ch);        // 1-16, 0 = off; default 15
+    uint8_t channel();
+
+    void    setFollowScale(bool on);       // third over held root → Ionian / Aeolian
+    void    setRepitch(bool on);           // also move the note that is sounding now
+}
@@ -0,0 +1,22 @@
+#!/bin/sh
+#  build.sh  ──────────────────────────────────────────────────────────────
+#  Builds linux/qm_rt: the sketch's engine sources compiled unchanged
+#  against the host shim in linux/shim, plus the real-time driver.
+#  Panel-only modules (EEPROM store, song chain, the .ino) are left out.
+#
+#    linux/build.sh            → linux/qm_rt
+#    CXX=clang++ linux/build.sh
+#  ------------------------------------------------------------------------
+set -e
+cd "$(dirname "$0")"
+
+ENGINE="sequencer clock_engine hw_inputs ui undo sysex tick_wheel voices
+        generators scales cc_map key_follow"
+
+SRC=""
+for m in $ENGINE; do SRC="$SRC ../$m.cpp"; done
+
+${CXX:-g++} -std=gnu++17 -O2 -Wall -Wextra -Wno-unused-function \
+    -I shim -I .. $SRC shim/arduino_host.cpp engine_glue.cpp rt_engine.cpp \
+    -o qm_rt -pthread
+echo "built $(pwd)/qm_rt"
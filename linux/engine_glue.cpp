@@ -0,0 +1,82 @@
+/*  engine_glue.cpp  ──────────────────────────────────────────────────────
+    Engine side of the Linux driver (see engine_glue.h)
+    ---------------------------------------------------------------------- */
+
+#include "engine_glue.h"
+#include "hw_inputs.h"
+#include "sequencer.h"
+#include "clock_engine.h"
+#include "ui.h"
+#include "cc_map.h"
+#include "key_follow.h"
+#include "midi_port.h"
+
+static TapSerial midiSerial(Serial);
+MidiPort MIDI(midiSerial);
+
+namespace {
+    /* order = hw::Param */
+    const char* const kParamNames[] = {
+        "pitch1", "pitch2", "pitch3", "pitch4", "pitch5", "pitch6", "pitch7", "pitch8",
+        "oct1", "oct2", "oct3", "oct4", "oct5", "oct6", "oct7", "oct8",
+        "dpitch", "dvel", "doct", "dacc",
+        "density", "destructive", "nondest", "instant", "accent",
+        "tempo", "loopstart", "loopend", "root", "velocity", "accentvel", "scale",
+        "swing", "nudge", "ratchet", "chord",
+        "pitchgen", "gategen", "euclidrot",
+        "quantrotate", "quantcommit", "quantinstant", "quantreset",
+        "chain",
+        "keychannel", "keyscale", "keyrepitch",
+        "ccchannel",
+    };
+    constexpr uint8_t kNames = sizeof kParamNames / sizeof kParamNames[0];
+    static_assert(kNames == (uint8_t)hw::Param::Count, "one name per hw::Param");
+}
+
+void glue::seed(unsigned long s) { randomSeed(s); }
+
+void glue::setup()
+{
+    /* the sketch's setup(), minus EEPROM, song chain and the panel */
+    hw::initPins();
+    for (uint8_t i = 0; i < 3; ++i) hw::scanInputs();       // one full pot pass
+    seq::forceStep(hw::pots.loopStart - 1);
+    clock::init();
+    seq::init();
+    cc::init();
+    key::init();
+    ui::init();
+
+    /* slave the engine to the driver: external sync, transport on */
+    hw::btnExtMidi.level = true;
+    hw::btnOnOff.level   = true;
+    clock::service();                                       // picks up usingExt
+    if (MIDI.start) MIDI.start();
+}
+
+void glue::tick()
+{
+    MIDI.sendRealTime(midi::Clock);                         // downstream gear follows us
+    if (MIDI.clock) MIDI.clock();                           // the engine's clock handler
+    hw::scanInputs();
+    clock::service();                                       // steps + tick wheel
+}
+
+void glue::stop()                 { if (MIDI.stop) MIDI.stop(); }
+uint16_t glue::bpm()              { return hw::pots.bpm ? hw::pots.bpm : 120; }
+
+int glue::paramIndex(const char* name)
+{
+    for (uint8_t i = 0; i < kNames; ++i)
+        if (!strcmp(name, kParamNames[i])) return i;
+    return -1;
+}
+
+void glue::set  (uint8_t p, int16_t v) { if (p < kNames) hw::setParamValue(hw::Param(p), v); }
+void glue::param(uint8_t p, uint8_t v) { if (p < kNames) hw::setParam(hw::Param(p), v); }
+void glue::cc   (uint8_t n, uint8_t v) { cc::handle(cc::channel(), n, v); }
+
+void glue::note(uint8_t n)
+{
+    if (MIDI.noteOn && key::channel()) MIDI.noteOn(key::channel(), n & 0x7F, 100);
+}
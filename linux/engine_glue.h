@@ -0,0 +1,29 @@
+#pragma once
+/*  engine_glue.h  ────────────────────────────────────────────────────────
+    The engine as the real-time driver sees it.  Kept free of Arduino
+    and engine headers: the engine's `namespace clock` and the shim's
+    min/max macros cannot share a translation unit with <time.h> and
+    the standard library.
+    ---------------------------------------------------------------------- */
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace host {
+    void emit(const uint8_t* b, size_t n);      // defined by the driver
+}
+
+namespace glue {
+
+    void     seed(unsigned long s);   // random() for the generators
+    void     setup();                 // the sketch's setup(), engine slaved to tick()
+    void     tick();                  // one 24-PPQN clock: steps + tick wheel
+    void     stop();                  // transport stop – sounding notes end
+    uint16_t bpm();
+
+    int      paramIndex(const char* name);          // hw::Param by name, -1 = none
+    void     set  (uint8_t param, int16_t value);   // field units
+    void     param(uint8_t param, uint8_t v7);      // pot / CC curve
+    void     cc   (uint8_t num,   uint8_t v7);      // through the CC map
+    void     note (uint8_t note);                   // key follow
+}
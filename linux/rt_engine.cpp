@@ -0,0 +1,279 @@
+/*  rt_engine.cpp  ────────────────────────────────────────────────────────
+    Headless real-time Linux host for the sequencer + clock engine.
+
+      tick thread   (SCHED_FIFO)  clock_nanosleep to each 24-PPQN tick,
+                                  applies queued control commands, feeds
+                                  the engine one MIDI clock, and stamps
+                                  every byte it emits with the tick's
+                                  deadline
+      writer thread               drains the byte queue into the output
+                                  (FIFO / file / stdout), one write() per
+                                  batch, and records tick→byte latency
+      control (main)              reads text commands from stdin or a
+                                  control file
+
+    The threads only share two lock-free single-producer/single-consumer
+    rings, plus an eventfd that wakes the writer.
+
+    Control commands, one per line:
+      set <param> <value>      field units, e.g.  set tempo 140
+      param <param> <0-127>    as a CC: 0 = field min, 127 = max
+      cc <num> <0-127>         through the CC map (cc_map.cpp)
+      note <0-127>             key follow, as a NoteOn on the key channel
+      quit
+    <param> is a hw::Param name, see kParamNames in engine_glue.cpp.
+
+    usage:  qm_rt [--out PATH|-] [--control PATH|-] [--seconds N]
+                  [--prio N] [--seed N]          --prio 0 = no SCHED_FIFO
+    ---------------------------------------------------------------------- */
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "engine_glue.h"
+
+/* ───────── lock-free SPSC ring ─────────────────────────────────────── */
+namespace {
+
+template<class T, size_t N>
+class Spsc {
+    static_assert((N & (N - 1)) == 0, "ring size must be a power of two");
+public:
+    bool push(const T& v)
+    {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) == N) return false;
+        buf[h & (N - 1)] = v;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+    bool pop(T& v)
+    {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire)) return false;
+        v = buf[t & (N - 1)];
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+private:
+    T buf[N];
+    alignas(64) std::atomic<size_t> head{0};
+    alignas(64) std::atomic<size_t> tail{0};
+};
+
+struct StampedByte { uint64_t stamp; uint8_t b; };
+
+enum class CmdKind : uint8_t { Set, Param, Cc, Note };
+struct Cmd { CmdKind kind; uint8_t a; int16_t v; };
+
+Spsc<StampedByte, 8192> outQ;            // tick thread → writer
+Spsc<Cmd, 256>          cmdQ;            // control     → tick thread
+
+int               wakeFd = -1;           // eventfd: "bytes queued"
+std::atomic<bool> running{true};
+std::atomic<bool> tickerDone{false};     // last bytes (stop flush) are queued
+uint64_t          tickStamp = 0;         // deadline of the tick being run
+std::atomic<uint64_t> dropped{0};        // bytes lost to a full ring
+
+inline uint64_t nowNs()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return uint64_t(ts.tv_sec) * 1000000000u + ts.tv_nsec;
+}
+
+/* preallocated sample buffers – no allocation on the real-time path */
+struct Samples {
+    std::vector<uint32_t> v;
+    explicit Samples(size_t n) { v.reserve(n); }
+    void add(uint64_t ns) { if (v.size() < v.capacity()) v.push_back(uint32_t(std::min<uint64_t>(ns, UINT32_MAX))); }
+};
+Samples wakeJitter(1 << 20);             // tick thread only
+Samples byteLatency(1 << 20);            // writer thread only
+
+} // namespace
+
+/* engine bytes land here (HardwareSerial::write in the shim) */
+void host::emit(const uint8_t* b, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+        if (!outQ.push({ tickStamp, b[i] })) dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+/* ───────── tick thread ─────────────────────────────────────────────── */
+namespace {
+
+void applyCmd(const Cmd& c)
+{
+    switch (c.kind) {
+        case CmdKind::Set:   glue::set  (c.a, c.v);          break;
+        case CmdKind::Param: glue::param(c.a, uint8_t(c.v)); break;
+        case CmdKind::Cc:    glue::cc   (c.a, uint8_t(c.v)); break;
+        case CmdKind::Note:  glue::note (c.a);               break;
+    }
+}
+
+void tickThread()
+{
+    uint64_t next = nowNs();
+    tickStamp = next;
+    glue::setup();
+
+    while (running.load(std::memory_order_relaxed)) {
+        next += 60000000000ull / (uint64_t(glue::bpm()) * 24);
+        timespec ts = { time_t(next / 1000000000u), long(next % 1000000000u) };
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {}
+        wakeJitter.add(nowNs() - next);
+        tickStamp = next;
+
+        Cmd c;
+        while (cmdQ.pop(c)) applyCmd(c);
+
+        glue::tick();
+
+        uint64_t one = 1;
+        if (write(wakeFd, &one, sizeof one) < 0) {}         // wake the writer
+    }
+
+    glue::stop();                                           // flush sounding notes
+    tickerDone.store(true, std::memory_order_release);
+    uint64_t one = 1;
+    if (write(wakeFd, &one, sizeof one) < 0) {}
+}
+
+/* ───────── writer thread ───────────────────────────────────────────── */
+void writerThread(int fd)
+{
+    uint8_t  buf[512];
+    uint64_t stamps[512];
+    for (;;) {
+        bool last = tickerDone.load(std::memory_order_acquire);   // before draining
+        uint64_t n;
+        if (!last && read(wakeFd, &n, sizeof n) < 0 && errno != EINTR) break;
+
+        for (;;) {
+            size_t len = 0;
+            StampedByte sb;
+            while (len < sizeof buf && outQ.pop(sb)) { buf[len] = sb.b; stamps[len++] = sb.stamp; }
+            if (!len) break;
+
+            for (size_t off = 0; off < len; ) {
+                ssize_t w = write(fd, buf + off, len - off);
+                if (w < 0) { if (errno == EINTR) continue; perror("write"); return; }
+                off += size_t(w);
+            }
+            uint64_t t = nowNs();
+            for (size_t i = 0; i < len; ++i)                // one sample per tick in the batch
+                if (!i || stamps[i] != stamps[i - 1]) byteLatency.add(t - stamps[i]);
+        }
+        if (last) break;                                    // everything after stop is out
+    }
+}
+
+/* ───────── report ──────────────────────────────────────────────────── */
+void report(const char* what, std::vector<uint32_t>& v)
+{
+    if (v.empty()) { fprintf(stderr, "%-14s no samples\n", what); return; }
+    std::sort(v.begin(), v.end());
+    auto pct = [&](double p) { return v[std::min(v.size() - 1, size_t(p * v.size()))] / 1000.0; };
+    fprintf(stderr, "%-14s n=%-8zu p50 %8.1f  p90 %8.1f  p99 %8.1f  p99.9 %8.1f  max %8.1f us\n",
+            what, v.size(), pct(0.50), pct(0.90), pct(0.99), pct(0.999), v.back() / 1000.0);
+}
+
+void onSignal(int) { running.store(false); }
+
+bool parseCmd(const char* line, Cmd& c)
+{
+    char verb[16] = {0}, arg[24] = {0};
+    int  val = 0;
+    int  n = sscanf(line, "%15s %23s %d", verb, arg, &val);
+    if (n < 2) return false;
+    if (!strcmp(verb, "note")) { c = { CmdKind::Note, uint8_t(atoi(arg) & 0x7F), 0 }; return true; }
+    if (n < 3) return false;
+    if (!strcmp(verb, "cc"))   { c = { CmdKind::Cc, uint8_t(atoi(arg) & 0x7F), int16_t(val) }; return true; }
+    int p = glue::paramIndex(arg);
+    if (p < 0) return false;
+    if (!strcmp(verb, "set"))   { c = { CmdKind::Set,   uint8_t(p), int16_t(val) }; return true; }
+    if (!strcmp(verb, "param")) { c = { CmdKind::Param, uint8_t(p), int16_t(val) }; return true; }
+    return false;
+}
+
+} // namespace
+
+/* ───────── main: options, threads, control loop ───────────────────── */
+int main(int argc, char** argv)
+{
+    const char* outPath = "-";
+    const char* ctlPath = "-";
+    int seconds = 0, prio = 80;
+    unsigned long seed = 1;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if      (!strcmp(argv[i], "--out"))     outPath = argv[i + 1];
+        else if (!strcmp(argv[i], "--control")) ctlPath = argv[i + 1];
+        else if (!strcmp(argv[i], "--seconds")) seconds = atoi(argv[i + 1]);
+        else if (!strcmp(argv[i], "--prio"))    prio    = atoi(argv[i + 1]);
+        else if (!strcmp(argv[i], "--seed"))    seed    = strtoul(argv[i + 1], nullptr, 0);
+        else { fprintf(stderr, "unknown option %s\n", argv[i]); return 2; }
+    }
+
+    int outFd = strcmp(outPath, "-") ? open(outPath, O_WRONLY | O_CREAT | O_TRUNC, 0644) : 1;
+    if (outFd < 0) { perror(outPath); return 1; }
+    FILE* ctl = strcmp(ctlPath, "-") ? fopen(ctlPath, "r") : stdin;
+    if (!ctl) { perror(ctlPath); return 1; }
+
+    wakeFd = eventfd(0, 0);
+    if (wakeFd < 0) { perror("eventfd"); return 1; }
+    if (mlockall(MCL_CURRENT | MCL_FUTURE)) perror("mlockall (continuing)");
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+    signal(SIGPIPE, SIG_IGN);
+    glue::seed(seed);
+
+    std::thread writer(writerThread, outFd);
+    std::thread ticker(tickThread);
+
+    sched_param sp{};
+    sp.sched_priority = prio;
+    if (prio > 0)                                           // --prio 0: leave it SCHED_OTHER
+        if (int e = pthread_setschedparam(ticker.native_handle(), SCHED_FIFO, &sp))
+            fprintf(stderr, "SCHED_FIFO %d: %s (continuing at normal priority)\n", prio, strerror(e));
+
+    /* control: a detached reader, so a blocking stdin never holds up exit */
+    std::thread([ctl] {
+        char line[128];
+        while (running.load() && fgets(line, sizeof line, ctl)) {
+            if (!strncmp(line, "quit", 4)) { running.store(false); break; }
+            Cmd c;
+            if (parseCmd(line, c)) { while (!cmdQ.push(c)) usleep(1000); }
+            else if (line[0] != '#' && line[0] != '\n') fprintf(stderr, "? %s", line);
+        }
+    }).detach();
+
+    uint64_t until = seconds ? nowNs() + uint64_t(seconds) * 1000000000u : 0;
+    while (running.load() && (!until || nowNs() < until)) usleep(20000);
+    running.store(false);
+
+    ticker.join();
+    writer.join();
+    if (outFd != 1) close(outFd);
+
+    report("wake jitter", wakeJitter.v);
+    report("tick->byte", byteLatency.v);
+    if (dropped.load()) fprintf(stderr, "dropped %llu bytes (output ring full)\n",
+                                (unsigned long long)dropped.load());
+    return 0;
+}
@@ -0,0 +1,19 @@
+#pragma once
+/* host shim: headless – the strip accepts everything and shows nothing */
+#include <stdint.h>
+#define NEO_GRB    0x52
+#define NEO_KHZ800 0x0000
+
+class Adafruit_NeoPixel {
+public:
+    Adafruit_NeoPixel(uint16_t, int16_t, uint16_t) {}
+    void     begin() {}
+    void     show() {}
+    bool     canShow() { return true; }
+    void     setBrightness(uint8_t) {}
+    void     setPixelColor(uint16_t, uint32_t) {}
+    void     setPixelColor(uint16_t, uint8_t, uint8_t, uint8_t) {}
+    uint16_t numPixels() const { return 16; }
+    static uint32_t Color(uint8_t r, uint8_t g, uint8_t b) { return uint32_t(r) << 16 | uint32_t(g) << 8 | b; }
+    static uint8_t  gamma8(uint8_t x) { return x; }
+};
@@ -0,0 +1,74 @@
+#pragma once
+/*  Arduino.h (host shim)  ────────────────────────────────────────────────
+    Just enough of the Arduino core for the engine sources to build on
+    Linux.  Pins are inert, time comes from CLOCK_MONOTONIC, and every
+    byte written to Serial goes to host::emit() – the real-time engine
+    stamps it and hands it to the writer thread.
+    ---------------------------------------------------------------------- */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <avr/pgmspace.h>
+#include <avr/interrupt.h>
+
+typedef bool    boolean;
+typedef uint8_t byte;
+
+#define A4 18
+#define A5 19
+#define A6 20
+#define A7 21
+#define HIGH   1
+#define LOW    0
+#define OUTPUT 1
+#define INPUT  0
+
+#define F(s) (s)
+
+#define bitRead(v, b)   (((v) >> (b)) & 1)
+#define bitSet(v, b)    ((v) |=  (1UL << (b)))
+#define bitClear(v, b)  ((v) &= ~(1UL << (b)))
+#define bit(b)          (1UL << (b))
+#define lowByte(w)      ((uint8_t)((w) & 0xFF))
+#define highByte(w)     ((uint8_t)((w) >> 8))
+#define constrain(a, l, h) ((a) < (l) ? (l) : ((a) > (h) ? (h) : (a)))
+#ifndef abs
+#define abs(x)          ((x) > 0 ? (x) : -(x))
+#endif
+#define min(a, b)       ((a) < (b) ? (a) : (b))
+#define max(a, b)       ((a) > (b) ? (a) : (b))
+
+long map(long x, long inMin, long inMax, long outMin, long outMax);
+long random(long howBig);
+long random(long howSmall, long howBig);
+void randomSeed(unsigned long seed);
+
+unsigned long micros();
+unsigned long millis();
+inline void delayMicroseconds(unsigned) {}
+inline void delay(unsigned long) {}
+
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int  digitalRead(uint8_t) { return LOW; }
+int analogRead(uint8_t pin);                    // host::analogLevel, buttons up
+
+namespace host {
+    void emit(const uint8_t* b, size_t n);      // engine → stamped byte queue
+    extern int analogLevel;                     // what every pot reads (0-1023)
+}
+
+struct HardwareSerial {
+    void   begin(long) {}
+    int    available() { return 0; }
+    int    availableForWrite() { return 64; }
+    int    read() { return -1; }
+    size_t write(uint8_t b) { host::emit(&b, 1); return 1; }
+    size_t write(const uint8_t* b, size_t n) { host::emit(b, n); return n; }
+    template<class... T> void print(T&&...) {}  // debug prints are dropped
+    template<class... T> void println(T&&...) {}
+    void   flush() {}
+};
+extern HardwareSerial Serial;
@@ -0,0 +1,89 @@
+#pragma once
+/*  MIDI.h (host shim)  ───────────────────────────────────────────────────
+    The slice of the FortySevenEffects MidiInterface the engine uses.
+    Output is plain bytes on Serial (full status, no running status –
+    like the library's defaults).  Input handlers are only stored: the
+    host engine calls them directly (clock ticks, control commands), so
+    read() never pulls a byte through the transport.
+    ---------------------------------------------------------------------- */
+
+#include <Arduino.h>
+
+#define MIDI_NAMESPACE     midi
+#define MIDI_CHANNEL_OMNI  0
+#define MIDI_CREATE_DEFAULT_INSTANCE()                                     \
+    midi::SerialMIDI<HardwareSerial> serialMIDI(Serial);                   \
+    midi::MidiInterface<midi::SerialMIDI<HardwareSerial>> MIDI(serialMIDI)
+
+namespace midi {
+
+typedef uint8_t DataByte;
+typedef uint8_t Channel;
+
+enum MidiType : uint8_t {
+    InvalidType = 0x00, NoteOff = 0x80, NoteOn = 0x90, ControlChange = 0xB0,
+    ProgramChange = 0xC0, SystemExclusive = 0xF0, Clock = 0xF8,
+    Start = 0xFA, Continue = 0xFB, Stop = 0xFC,
+};
+
+struct DefaultSettings { static const unsigned SysExMaxSize = 128; };
+
+template<class Port> class SerialMIDI {
+public:
+    explicit SerialMIDI(Port& p) : port(p) {}
+    byte read() { return byte(port.read()); }
+private:
+    Port& port;
+};
+
+template<class Transport, class Settings = DefaultSettings>
+class MidiInterface {
+public:
+    explicit MidiInterface(Transport& t) : transport(t) {}
+
+    void begin(Channel = 1) {}
+    bool read() { return false; }
+    bool read(Channel) { return false; }
+    void turnThruOff() {}
+    void turnThruOn () {}
+
+    void sendNoteOn (DataByte n, DataByte v, Channel c) { send3(NoteOn,  n, v, c); }
+    void sendNoteOff(DataByte n, DataByte v, Channel c) { send3(NoteOff, n, v, c); }
+    void sendControlChange(DataByte n, DataByte v, Channel c) { send3(ControlChange, n, v, c); }
+    void sendRealTime(MidiType t) { Serial.write(uint8_t(t)); }
+    void sendSysEx(unsigned len, const uint8_t* b, bool withBounds = false)
+    {
+        if (!withBounds) Serial.write(0xF0);
+        Serial.write(b, len);
+        if (!withBounds) Serial.write(0xF7);
+    }
+
+    void setHandleClock   (void (*f)()) { clock = f; }
+    void setHandleStart   (void (*f)()) { start = f; }
+    void setHandleContinue(void (*f)()) { cont  = f; }
+    void setHandleStop    (void (*f)()) { stop  = f; }
+    void setHandleNoteOn       (void (*f)(Channel, DataByte, DataByte)) { noteOn  = f; }
+    void setHandleNoteOff      (void (*f)(Channel, DataByte, DataByte)) { noteOff = f; }
+    void setHandleControlChange(void (*f)(Channel, DataByte, DataByte)) { cc      = f; }
+    void setHandleProgramChange(void (*f)(Channel, DataByte))           { pc      = f; }
+    void setHandleSystemExclusive(void (*f)(uint8_t*, unsigned))        { sysex   = f; }
+
+    /* host side: the handlers the engine registered (may be null) */
+    void (*clock)() = nullptr, (*start)() = nullptr, (*cont)() = nullptr, (*stop)() = nullptr;
+    void (*noteOn)(Channel, DataByte, DataByte)  = nullptr;
+    void (*noteOff)(Channel, DataByte, DataByte) = nullptr;
+    void (*cc)(Channel, DataByte, DataByte)      = nullptr;
+    void (*pc)(Channel, DataByte)                = nullptr;
+    void (*sysex)(uint8_t*, unsigned)            = nullptr;
+
+private:
+    Transport& transport;
+
+    static void send3(MidiType t, DataByte a, DataByte b, Channel c)
+    {
+        const uint8_t m[3] = { uint8_t(t | ((c - 1) & 0x0F)), uint8_t(a & 0x7F), uint8_t(b & 0x7F) };
+        Serial.write(m, 3);
+    }
+};
+
+} // namespace midi
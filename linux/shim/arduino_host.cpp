@@ -0,0 +1,44 @@
+/*  arduino_host.cpp  ─────────────────────────────────────────────────────
+    Arduino core functions for the host shim (see Arduino.h)
+    ---------------------------------------------------------------------- */
+
+#include <time.h>
+#include "Arduino.h"
+
+HardwareSerial Serial;
+int host::analogLevel = 512;              // every pot at its centre detent
+
+namespace {
+    uint64_t monoUs()
+    {
+        timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return uint64_t(ts.tv_sec) * 1000000u + ts.tv_nsec / 1000;
+    }
+    const uint64_t bootUs = monoUs();
+
+    uint32_t rngState = 1;                // xorshift32 – deterministic per seed
+    uint32_t next32()
+    {
+        rngState ^= rngState << 13;
+        rngState ^= rngState >> 17;
+        rngState ^= rngState << 5;
+        return rngState;
+    }
+}
+
+unsigned long micros() { return (unsigned long)(monoUs() - bootUs); }
+unsigned long millis() { return (unsigned long)((monoUs() - bootUs) / 1000); }
+
+long map(long x, long inMin, long inMax, long outMin, long outMax)
+{
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+void randomSeed(unsigned long seed) { if (seed) rngState = uint32_t(seed); }
+long random(long howBig)            { return howBig > 0 ? long(next32() % uint32_t(howBig)) : 0; }
+long random(long lo, long hi)       { return hi > lo ? lo + random(hi - lo) : lo; }
+
+/* the mux pins are inert, so buttons read low (released) and pots
+   read the shared level                                               */
+int analogRead(uint8_t) { return host::analogLevel; }
@@ -0,0 +1,5 @@
+#pragma once
+/* host shim: the whole engine runs on the tick thread, so there is
+   nothing to mask                                                    */
+inline void noInterrupts() {}
+inline void interrupts() {}
@@ -0,0 +1,10 @@
+#pragma once
+/* host shim: flash is ordinary memory */
+#include <stdint.h>
+#include <string.h>
+#define PROGMEM
+#define PSTR(s)             (s)
+#define pgm_read_byte(a)    (*(const uint8_t*)(a))
+#define pgm_read_word(a)    (*(const uint16_t*)(a))
+#define pgm_read_ptr(a)     (*(void* const*)(a))
+#define memcpy_P            memcpy
@@ -0,0 +1,47 @@
+#pragma once
+#include <Arduino.h>
+#include <MIDI.h>
+#include "cc_map.h"              // CC_BENCH
+
+/*  midi_port.h  ──────────────────────────────────────────────────────────
+    The one MIDI port.  Every byte the library pulls off the UART passes
+    sysex::feed() first, so a SysEx load is parsed as it arrives inside
+    MIDI.read() – the library never buffers the frame (SysExMaxSize is
+    cut to the minimum, which also frees its 128-byte array).
+    Defined once in quartermaster.ino.
+    ---------------------------------------------------------------------- */
+
+namespace sysex { void feed(uint8_t b); }
+
+struct PortSettings : public MIDI_NAMESPACE::DefaultSettings {
+    static const unsigned SysExMaxSize = 8;      // frames are parsed in feed()
+};
+
+class TapSerial : public MIDI_NAMESPACE::SerialMIDI<HardwareSerial> {
+public:
+    explicit TapSerial(HardwareSerial& port)
+        : MIDI_NAMESPACE::SerialMIDI<HardwareSerial>(port) {}
+
+#if CC_BENCH
+    /* cc::bench() pushes a generated stream through the real parser */
+    static uint16_t benchLeft;
+    static byte   (*benchByte)();
+    unsigned available()
+    {
+        return benchLeft ? 1 : MIDI_NAMESPACE::SerialMIDI<HardwareSerial>::available();
+    }
+#endif
+
+    byte read()
+    {
+#if CC_BENCH
+        if (benchLeft) { --benchLeft; return benchByte(); }
+#endif
+        byte b = MIDI_NAMESPACE::SerialMIDI<HardwareSerial>::read();
+        sysex::feed(b);
+        return b;
+    }
+};
+
+typedef MIDI_NAMESPACE::MidiInterface<TapSerial, PortSettings> MidiPort;
+extern MidiPort MIDI;
@@ -0,0 +1,123 @@
+/*  pattern_store.cpp  ────────────────────────────────────────────────────
+    EEPROM pattern slots – background writer + wear-levelled copies
+    ---------------------------------------------------------------------- */
+
+#include "pattern_store.h"
+#include "sequencer.h"
+#include <EEPROM.h>
+#include <avr/eeprom.h>
+
+/* ───────── record layout ──────────────────────────────────────────────
+   [0..15] packed steps   [16] checksum   [17] sequence number
+   The sequence byte is written LAST: a record torn by a power cut still
+   carries the old (older) number and simply loses the newest-copy vote. */
+namespace {
+
+    constexpr uint8_t  kRecLen   = seq::kPackedLen + 2;
+    constexpr uint8_t  kSumIx    = seq::kPackedLen;
+    constexpr uint8_t  kSeqIx    = seq::kPackedLen + 1;
+    constexpr uint16_t kSlotSize = uint16_t(kRecLen) * store::kCopies;
+
+    static_assert(uint16_t(store::kSlots) * kSlotSize <= 1024, "fits ATmega328 EEPROM");
+
+    struct Newest { uint8_t copy; uint8_t seqNo; bool valid; };
+    Newest newest[store::kSlots];
+
+    uint8_t  wrBuf[kRecLen];
+    uint16_t wrBase = 0;
+    uint8_t  wrPos  = kRecLen;          // == kRecLen ⇒ idle
+    uint8_t  curSlot = 0;
+
+    inline uint16_t recAddr(uint8_t slot, uint8_t copy)
+    {
+        return uint16_t(slot) * kSlotSize + uint16_t(copy) * kRecLen;
+    }
+
+    uint8_t checksum(const uint8_t* steps, uint8_t seqNo)
+    {
+        uint8_t sum = seqNo;
+        for (uint8_t i = 0; i < seq::kPackedLen; ++i) sum += steps[i];
+        return sum ^ 0xA5;                        // erased 0xFF cells never pass
+    }
+
+    /* read one copy; false if it is erased, torn or corrupt */
+    bool readRec(uint8_t slot, uint8_t copy, uint8_t* steps, uint8_t& seqNo)
+    {
+        uint16_t a = recAddr(slot, copy);
+        for (uint8_t i = 0; i < seq::kPackedLen; ++i) {
+            steps[i] = EEPROM.read(a + i);
+            if (steps[i] & 0x80) return false;    // not a packed step
+        }
+        seqNo = EEPROM.read(a + kSeqIx);
+        return EEPROM.read(a + kSumIx) == checksum(steps, seqNo);
+    }
+}
+
+/* ───────── init – one pass over the EEPROM ───────────────────────── */
+void store::init()
+{
+    uint8_t steps[seq::kPackedLen];
+
+    for (uint8_t s = 0; s < kSlots; ++s) {
+        newest[s] = { kCopies - 1, 0, false };    // next save → copy 0
+        for (uint8_t c = 0; c < kCopies; ++c) {
+            uint8_t n;
+            if (!readRec(s, c, steps, n)) continue;
+            /* serial-number compare: later wins even across 255 → 0 */
+            if (!newest[s].valid || int8_t(n - newest[s].seqNo) > 0)
+                newest[s] = { c, n, true };
+        }
+    }
+}
+
+/* ───────── save – snapshot now, write later ──────────────────────── */
+bool store::save(uint8_t slot)
+{
+    if (slot >= kSlots || busy()) return false;
+
+    Newest& n   = newest[slot];
+    uint8_t cpy = (n.copy + 1) % kCopies;         // rotate through the ring
+    uint8_t nr  = n.seqNo + 1;
+
+    seq::exportPattern(wrBuf);
+    wrBuf[kSumIx] = checksum(wrBuf, nr);
+    wrBuf[kSeqIx] = nr;
+    wrBase = recAddr(slot, cpy);
+    wrPos  = 0;
+
+    n = { cpy, nr, true };                        // recall sees it once written
+    curSlot = slot;
+    return true;
+}
+
+/* ───────── service – at most one cell per loop, never waits ──────── */
+void store::service()
+{
+    if (wrPos >= kRecLen || !eeprom_is_ready()) return;
+
+    uint16_t a = wrBase + wrPos;
+    if (EEPROM.read(a) != wrBuf[wrPos])           // skip unchanged cells
+        EEPROM.write(a, wrBuf[wrPos]);            // starts the write, returns
+    ++wrPos;
+}
+
+bool store::busy() { return wrPos < kRecLen; }
+
+/* ───────── stage – decode now, seq swaps it in on a step edge ────── */
+bool store::stage(uint8_t slot)
+{
+    if (slot >= kSlots || !newest[slot].valid) return false;
+
+    uint8_t steps[seq::kPackedLen];
+    if (busy() && wrBase == recAddr(slot, newest[slot].copy)) {
+        memcpy(steps, wrBuf, seq::kPackedLen);    // still in flight – use RAM copy
+    } else {
+        uint8_t n;
+        if (!readRec(slot, newest[slot].copy, steps, n)) return false;
+    }
+    seq::stagePattern(steps);
+    curSlot = slot;
+    return true;
+}
+
+uint8_t store::current() { return curSlot; }
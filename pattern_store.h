@@ -0,0 +1,24 @@
+#pragma once
+#include <Arduino.h>
+
+/*  pattern_store.h  ──────────────────────────────────────────────────────
+    Pattern slots in EEPROM.  Writes trickle out one byte per service()
+    call, only when the EEPROM is idle, so a ~3.3 ms cell write never
+    stalls loop().  Every slot owns a ring of copies; each save goes to
+    the next copy (wear levelling) and recall picks the newest valid one.
+    ---------------------------------------------------------------------- */
+
+namespace store {
+
+    constexpr uint8_t kSlots  = 8;
+    constexpr uint8_t kCopies = 7;      // 8 × 7 × 18 B = 1008 B of 1 KB
+
+    void init();                  // call once in setup(): index newest copies
+    void service();               // call each loop(): ≤ 1 EEPROM byte
+
+    bool save (uint8_t slot);     // snapshot regular sequence; false = writer busy
+    bool stage(uint8_t slot);     // decode slot → seq staging; false = empty / corrupt
+    bool busy ();
+
+    uint8_t current();            // last slot saved or staged
+}
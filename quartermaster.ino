@@ -1,10 +1,37 @@
-#include <MIDI.h>
+#include "midi_port.h"
 #include "hw_inputs.h"
 #include "clock_engine.h"
 #include "sequencer.h"
 #include "ui.h"
+#include "pattern_store.h"
+#include "chain.h"
+#include "sysex.h"
+#include "cc_map.h"
+#include "key_follow.h"
+#include "tick_wheel.h"
+
+static TapSerial midiSerial(Serial);      // RX bytes pass sysex::feed()
+MidiPort MIDI(midiSerial);
+
+constexpr uint16_t SAVE_HOLD_MS = 1000;   // hold Copy this long → save slot
+constexpr uint8_t  NO_PROG      = 0xFF;
+static uint8_t pendingProg = NO_PROG;     // Program Change waiting for the EEPROM
+
+/* Program Change n → recall slot n on the next step.  Decoding reads the
+   EEPROM, which stalls while a save is writing, so the callback only
+   notes the slot and loop() stages it once the writer is idle.       */
+static void onProgramChange(midi::Channel, midi::DataByte prog)
+{
+    pendingProg = prog % store::kSlots;
+}
 
-MIDI_CREATE_DEFAULT_INSTANCE();
+static void servicePendingProg()
+{
+    if (pendingProg == NO_PROG || store::busy()) return;
+    if (!chain::running() && store::stage(pendingProg))   // the chain owns the idle bank
+        seq::schedule(seq::Action::Load);
+    pendingProg = NO_PROG;
+}
 
 void setup(){
     Serial.begin(31250);
@@ -13,6 +40,14 @@ void setup(){
     seq::forceStep(hw::pots.loopStart - 1);
     clock::init();
     seq::init();
+    store::init();
+    sysex::setChainHandler(chain::program);   // set lists arrive as SysEx cmd 04
+    MIDI.setHandleProgramChange(onProgramChange);
+    cc::init();
+    key::init();
+#if CC_BENCH
+    cc::bench();
+#endif
     ui::init();
 }
 
@@ -20,38 +55,81 @@ void setup(){
 void loop()
 {
     hw::scanInputs();
-    MIDI.read();
-
-    if (hw::btnInstant.edge) {                         //   BTN_INST
-        seq::regenerateAll(hw::pots.instChance);       //   make 16 new prospect notes
-        seq::commitProspect();                         //   and commit at once
-        ui::refresh();   // redraw pixels to show the new pattern
-        strip.show();    // commit once (still < 0.5 ms)
-        hw::btnInstant.edge = false;
-    }
 
-    if (hw::btnCopy.edge) {                            //   BTN_NONDEST
-        seq::commitProspect();                         //   promote last 16 temp steps
-    }
+    /* drain several queued messages per pass so a dense CC stream never
+       piles up in the 64-byte RX ring – bounded to keep loop() short */
+    for (uint8_t n = 0; n < 8 && MIDI.read(); ++n) {}
 
     /* ----------------------------------------------
-   Immediate performance buttons
+   Performance buttons – every press seen exactly once
    ---------------------------------------------- */
-    if (hw::btnCycleL.edge) {
-        seq::rotateAllLeft();
-        hw::btnCycleL.edge = false;
-        //flashLed(3, {0,60,0});            // same green wink
-    }
-
-    if (hw::btnCycleR.edge) {
-        seq::rotateAllRight();
-        hw::btnCycleR.edge = false;
-        //flashLed(5, {0,60,0});
+    static hw::EventReader buttons;
+    static uint16_t copyDownMs = 0;
+    static bool     copyArmed  = false;              // Copy down, not yet tap or hold
+    static bool     resetShifted = false;            // Reset used as a shift key
+    static uint8_t  cycleUsed    = 0;                // Cycle L / R (bit 0 / 1) used in a combo
+    hw::BtnEvent ev;
+    while (hw::nextEvent(buttons, ev)) {
+        if (buttons.lost) {                            //   overrun: a release may be
+            resetShifted = false;                      //   among the lost – drop any
+            cycleUsed    = 0;                          //   half-finished combo
+            copyArmed    = false;
+            buttons.lost = 0;
+        }
+        /* Copy: a tap commits on release; held past SAVE_HOLD_MS it saves
+           instead (below), so a save never commits first               */
+        if (ev.btn == hw::Btn::Copy) {
+            if (ev.press) { copyDownMs = ev.ms; copyArmed = true; }
+            else if (copyArmed) {
+                copyArmed = false;
+                seq::schedule(seq::Action::Commit);    //   promote last 16 temp steps
+            }
+        }
+        if (ev.btn == hw::Btn::Reset && !ev.press) {   //   reset fires on release …
+            if (!resetShifted)                         //   … unless it was a shift
+                seq::schedule(seq::Action::Reset);     //   quantised, next step by default
+            resetShifted = false;
+            //flashLed(4, {0,0,60});            // blue wink
+        }
+        /* Cycle rotates on release, so a combo can still claim the press */
+        if ((ev.btn == hw::Btn::CycleL || ev.btn == hw::Btn::CycleR) && !ev.press) {
+            uint8_t bit = ev.btn == hw::Btn::CycleL ? 1 : 2;
+            if (!(cycleUsed & bit))
+                seq::schedule(bit == 1 ? seq::Action::RotateLeft : seq::Action::RotateRight);
+            cycleUsed &= ~bit;
+        }
+        if (!ev.press) continue;
+
+        switch (ev.btn) {
+        case hw::Btn::Instant:                         //   BTN_INST – the one Instant path
+            seq::schedule(seq::Action::Instant);       //   16 new prospect notes + commit
+            break;
+
+        /* both Cycle buttons together = next LED page, no rotation.
+           Reset held + Cycle L / R = undo / redo.                          */
+        case hw::Btn::CycleL:
+        case hw::Btn::CycleR: {
+            bool    left  = ev.btn == hw::Btn::CycleL;
+            uint8_t bit   = left ? 1 : 2;
+            bool    other = left ? hw::btnCycleR.level : hw::btnCycleL.level;
+            if (hw::btnReset.level) {
+                resetShifted = true;
+                cycleUsed   |= bit;
+                seq::schedule(left ? seq::Action::Undo : seq::Action::Redo);
+            } else if (other) {
+                cycleUsed   |= 3;                      // neither release rotates
+                ui::nextPage();
+            }
+            break;
+        }
+
+        default: break;
+        }
     }
-
-    if (hw::btnReset.edge) {
-        seq::armReset();                  // will take effect on next tick
-        //flashLed(4, {0,0,60});            // blue wink
+    if (copyArmed && hw::btnCopy.level &&              //   hold edge = save slot
+        uint16_t(uint16_t(millis()) - copyDownMs) >= SAVE_HOLD_MS) {
+        copyArmed = false;
+        store::save(store::current());
     }
 
     static bool prevOn = false;
@@ -59,14 +137,15 @@ void loop()
 
     /* ---------- rising edge  (OFF → ON)  ------------------- */
     if ( on && !prevOn ) {
-        uint8_t target = hw::pots.loopStart ? hw::pots.loopStart - 1 : 0;
+        uint8_t target = seq::loopStart() ? seq::loopStart() - 1 : 0;
         seq::forceStep(target);            // jump to first step *before* clock runs
+        clock::hardResetCounters();        // step + bar phase start here
     }
 
     /* ---------- falling edge  (ON → OFF) -------------------- */
     if (!on &&  prevOn ) {
-        MIDI.sendControlChange(123, 0, 1);    // all notes off
-        uint8_t target = hw::pots.loopEnd ? hw::pots.loopEnd - 1 : 15;
+        wheel::flush();                    // queued offs now, ratchets dropped, CC 123
+        uint8_t target = seq::loopEnd() ? seq::loopEnd() - 1 : 15;
         seq::forceStep(target);            // park at last step
     }
 
@@ -77,6 +156,11 @@ void loop()
     }
 
     ui::refresh();
+    ui::commit(true);                    // internal clock: now; external: step edge
+    store::service();                    // ≤ 1 EEPROM byte, never blocks
+    servicePendingProg();                // Program Change, once the writer is idle
+    chain::service();                    // prefetch next entry off the clock edge
+    sysex::service();                    // trickle an outgoing dump
     prevOn = on;
 
     //dbgPrint();
@@ -88,9 +172,12 @@ void dbgPrint()
     static uint8_t prevStart = 0, prevEnd = 0;
     static uint8_t prevPP    = 0;
     static bool    pendingEdge = false;   // latch Destruct press
+    static hw::EventReader dbgEvents;
 
     /* latch the edge immediately */
-    if (hw::btnDestruct.edge) pendingEdge = true;
+    hw::BtnEvent ev;
+    while (hw::nextEvent(dbgEvents, ev))
+        if (ev.btn == hw::Btn::Destruct && ev.press) pendingEdge = true;
 
     /* only print a few times per second */
     if (millis() - lastMs < 300) return;
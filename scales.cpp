@@ -0,0 +1,72 @@
+/*  scales.cpp  ───────────────────────────────────────────────────────────
+    Compile-time scale tables (PROGMEM) + the one user scale in RAM
+    ---------------------------------------------------------------------- */
+
+#include "scales.h"
+#include <avr/pgmspace.h>
+
+namespace {
+
+    /* ───────── generators (C++11 constexpr – single expression) ────── */
+    constexpr uint8_t kIonianSteps[7] = {2,2,1,2,2,2,1};
+
+    /* church mode m = Ionian step pattern rotated by m */
+    constexpr uint8_t modeDeg(uint8_t m, uint8_t d)
+    {
+        return d == 0 ? 0 : modeDeg(m, d - 1) + kIonianSteps[(m + d - 1) % 7];
+    }
+
+    /* any scale given as steps, wrapped past the octave for short scales */
+    constexpr uint8_t stepsDeg(const uint8_t* st, uint8_t n, uint8_t d)
+    {
+        return d == 0 ? 0 : stepsDeg(st, n, d - 1) + st[(d - 1) % n];
+    }
+
+    constexpr uint8_t kPentMajSteps[5] = {2,2,3,2,3};
+    constexpr uint8_t kPentMinSteps[5] = {3,2,2,3,2};
+    constexpr uint8_t kHarmMinSteps[7] = {2,1,2,2,1,3,1};
+    constexpr uint8_t kMelMinSteps [7] = {2,1,2,2,2,2,1};
+
+    #define QM_MODE(m)    { modeDeg(m,0), modeDeg(m,1), modeDeg(m,2), modeDeg(m,3), \
+                            modeDeg(m,4), modeDeg(m,5), modeDeg(m,6), modeDeg(m,7) }
+    #define QM_STEPS(s,n) { stepsDeg(s,n,0), stepsDeg(s,n,1), stepsDeg(s,n,2), stepsDeg(s,n,3), \
+                            stepsDeg(s,n,4), stepsDeg(s,n,5), stepsDeg(s,n,6), stepsDeg(s,n,7) }
+
+    const uint8_t kTables[scale::User][scale::kDegrees] PROGMEM = {
+        QM_MODE(0),                       // Ionian     0 2 4 5 7 9 11 12
+        QM_MODE(1),                       // Dorian
+        QM_MODE(2),                       // Phrygian
+        QM_MODE(3),                       // Lydian
+        QM_MODE(4),                       // Mixolydian
+        QM_MODE(5),                       // Aeolian
+        QM_MODE(6),                       // Locrian
+        QM_STEPS(kPentMajSteps, 5),       // 0 2 4 7 9 12 14 16
+        QM_STEPS(kPentMinSteps, 5),       // 0 3 5 7 10 12 15 17
+        QM_STEPS(kHarmMinSteps, 7),       // 0 2 3 5 7 8 11 12
+        QM_STEPS(kMelMinSteps , 7),       // 0 2 3 5 7 9 11 12
+    };
+
+    #undef QM_MODE
+    #undef QM_STEPS
+
+    static_assert(modeDeg(0,7) == 12 && modeDeg(3,3) == 6, "mode generator");
+    static_assert(stepsDeg(kPentMinSteps,5,5) == 12,        "steps generator");
+
+    uint8_t userTable[scale::kDegrees] = {0,2,4,5,7,9,11,12};   // starts as Ionian
+    uint8_t userRev = 0;
+}
+
+uint8_t scale::interval(uint8_t id, uint8_t degree)
+{
+    degree &= 0x07;
+    if (id >= User) return userTable[degree];
+    return pgm_read_byte(&kTables[id][degree]);
+}
+
+void scale::setUser(const uint8_t* offsets)
+{
+    memcpy(userTable, offsets, kDegrees);
+    ++userRev;
+}
+
+uint8_t scale::revision() { return userRev; }
@@ -0,0 +1,31 @@
+#pragma once
+#include <Arduino.h>
+
+/*  scales.h  ─────────────────────────────────────────────────────────────
+    Scale library.  Every built-in scale is eight semitone offsets
+    (degree 0-7, degree 7 = the octave or the next scale tone above it),
+    computed at compile time and stored in PROGMEM.  One RAM scale is
+    left for the user, loaded over SysEx (cmd 03, see sysex.h); until
+    then it plays Ionian.
+    ---------------------------------------------------------------------- */
+
+namespace scale {
+
+    enum Id : uint8_t {
+        Ionian, Dorian, Phrygian, Lydian, Mixolydian, Aeolian, Locrian,
+        PentMajor, PentMinor, HarmonicMinor, MelodicMinor,
+        User,
+        Count
+    };
+
+    constexpr uint8_t kDegrees = 8;
+
+    /* semitone offset of `degree` (0-7) in scale `id` – one flash read */
+    uint8_t interval(uint8_t id, uint8_t degree);
+
+    /* user scale: eight ascending offsets, copied into RAM */
+    void    setUser(const uint8_t* offsets);
+
+    /* bumps whenever setUser() runs – lets callers keep derived caches */
+    uint8_t revision();
+}
@@ -2,12 +2,14 @@
 #include "sequencer.h"
 #include "clock_engine.h"
 #include "ui.h"
-#include <MIDI.h>
+#include "scales.h"
+#include "undo.h"
+#include "sysex.h"
+#include "tick_wheel.h"
+#include "voices.h"
+#include "generators.h"
+#include "midi_port.h"
 
-/*  exact extern using the namespace chosen by the library  */
-extern MIDI_NAMESPACE::MidiInterface<
-           MIDI_NAMESPACE::SerialMIDI<HardwareSerial>
-       > MIDI;
 using namespace MIDI_NAMESPACE;          // lets you write just “MIDI.send…”
 
 
@@ -37,20 +39,115 @@ namespace {
         }
     }
 
-    struct Track { uint8_t regularSequence[kSteps]={0}; uint8_t prospectiveSequence[kSteps]={0}; };
+    /* a lane's two step arrays, wherever they live, plus an idle row a
+       prepared Instant draws into ahead of its boundary               */
+    struct LaneData {
+        uint8_t* regularSequence;
+        uint8_t* prospectiveSequence;
+        uint8_t* spare;
+    };
+
+    /* two banks per track: the live one plays, the other is where the
+       next pattern is decoded ahead of time – a load is a pointer swap */
+    struct Track : LaneData {
+        uint8_t  bank[2][2][kSteps] = {};         // [bank][regular, prospect]
+        uint8_t  live = 0;
+
+        Track() : LaneData{ bank[0][0], bank[0][1], bank[1][1] } {}
+
+        uint8_t* nextRegular () { return bank[live ^ 1][0]; }
+        uint8_t* nextProspect() { return bank[live ^ 1][1]; }
+        void swap() {
+            live ^= 1;
+            regularSequence     = bank[live][0];
+            prospectiveSequence = bank[live][1];
+            spare               = nextProspect();
+        }
+    };
+
+    /* extra lanes live outside the packed step: one bank, so a Load
+       resets them to their home value rather than swapping them     */
+    struct FlatLane : LaneData {
+        uint8_t buf[3][kSteps] = {};
+        FlatLane() : LaneData{ buf[0], buf[1], buf[2] } {}
+    };
 
     Track trPitch, trVel, trOct, trAcc;
 
+    /* groove: bits 0-3 nudge in 1/32 steps, bits 4-5 ratchet count − 1,
+       bits 6-7 chord (kChords row).  Regular + prospect like any lane,
+       so regenerateAll() redraws it under the gate lane's Δ coin.     */
+    FlatLane trGroove;
+#if LANE_GATE_LEN
+    FlatLane trGate;              // 0 = full step … 3 = ¼ step
+#endif
+#if LANE_CC
+    FlatLane trCc;                // 0-127
+#endif
+
     uint8_t curStep = 0;
 
-    inline Track& track(seq::Aspect a){
-        switch(a){
-            case seq::Aspect::Pitch: return trPitch;
-            case seq::Aspect::Vel:   return trVel;
-            case seq::Aspect::Oct:   return trOct;
-            default:                 return trAcc;
-        }
+    /* output pitch for [octave -1/0/+1][degree] at the current root +
+       scale.  Rebuilt only when those pots (or the user scale) change. */
+    uint8_t pitchTable[3][scale::kDegrees];
+    uint8_t ptRoot = 255, ptScale = 255, ptRev = 0;
+    uint8_t ptPeriod = 7;         // scale tones per octave (5 for pentatonics)
+
+    void refreshPitchTable()
+    {
+        uint8_t root = hw::pots.root;
+        uint8_t sc   = constrain(hw::pots.scale, 1, uint8_t(scale::Count)) - 1;
+        uint8_t rev  = scale::revision();
+        if (root == ptRoot && sc == ptScale && rev == ptRev) return;
+        ptRoot = root; ptScale = sc; ptRev = rev;
+
+        ptPeriod = 7;
+        for (uint8_t d = 1; d < scale::kDegrees; ++d)
+            if (scale::interval(sc, d) >= 12) { ptPeriod = d; break; }
+
+        for (uint8_t o = 0; o < 3; ++o)
+            for (uint8_t d = 0; d < scale::kDegrees; ++d) {
+                int16_t p = int16_t(root) + scale::interval(sc, d) + (int16_t(o) - 1) * 12;
+                while (p > 127) p -= 12;        // fold by octaves – stays in key
+                while (p < 0)   p += 12;
+                pitchTable[o][d] = p;
+            }
     }
+    /* chord voicings as scale-degree offsets from the step's degree,
+       stacked in the current mode – 0xFF ends a chord               */
+    constexpr uint8_t kMaxVoices = 4;
+    static_assert(kMaxVoices <= wheel::kTones, "every chord tone needs a wheel tag");
+    const uint8_t kChords[4][kMaxVoices] PROGMEM = {
+        { 0, 0xFF },                      // single note
+        { 0, 2, 4, 0xFF },                // triad
+        { 0, 2, 4, 6 },                   // seventh
+        { 0, 3, 6, 0xFF },                // stack of fourths
+    };
+
+    /* voice k of a chord on `degree` – wraps past the scale's period
+       into the next octave, so pentatonic chords stay in key          */
+    uint8_t chordPitch(uint8_t degree, uint8_t octIx, uint8_t step)
+    {
+        if (!step) return pitchTable[octIx][degree];
+        uint8_t d = degree + step, up = 0;
+        while (d >= ptPeriod) { d -= ptPeriod; up += 12; }
+        int16_t p = int16_t(ptRoot) + scale::interval(ptScale, d) + up + (int16_t(octIx) - 1) * 12;
+        while (p > 127) p -= 12;
+        while (p < 0)   p += 12;
+        return uint8_t(p);
+    }
+
+    /* what nextStep() left sounding – lets a live transpose move it */
+    uint8_t soundDeg = 0, soundOct = 1, soundVel = 0, soundChord = 0;
+    uint8_t soundPitch[kMaxVoices];
+
+    uint8_t lastBar = 0;          // clock::bars() at the previous step
+
+    /* regular-sequence change mask for the UI – starts all-dirty so the
+       first refresh() paints every pixel */
+    uint16_t changedSteps = 0xFFFF;
+
+    inline void markChanged(uint8_t s) { changedSteps |= uint16_t(1) << s; }
 
     /* ------------------------------------------------------
    helper:  per-degree octave displacement  (-1 / 0 / +1)
@@ -70,28 +167,112 @@ namespace {
         return 0;   // mid detent
     }
 
-    uint8_t generate(seq::Aspect a)
-    {
-        using namespace hw;
-        switch(a){
-            case seq::Aspect::Pitch:
-                return weightedRandomSelection(8, pots.pitchProb);   // helper below
-            /* ---- Velocity (gate on/off) --------- */
-            case seq::Aspect::Vel:
-                return random(128) < hw::pots.density;     // 1 = gate present
-
-            /* ---- Octave displacement ------------ */
-            case seq::Aspect::Oct: {
-                uint8_t deg = trPitch.prospectiveSequence[curStep] & 0x07;
-                return octaveDisplacement(deg) + 1;        // store 0,1,2
-            }
+    /* ───────── lane generators: a fresh value for step s ───────── */
+    inline uint8_t prevStep(uint8_t s) { return (s + kSteps - 1) % kSteps; }
 
-            /* ---- V1 / V2 selector --------------- */
-            case seq::Aspect::Acc:
-                if (!trVel.prospectiveSequence[curStep])   // no gate? → stay Velocity-1
-                    return 0;
-                return random(128) < hw::pots.accentChance;  // 1 = Velocity-2
+    uint8_t genPitch(uint8_t s)
+    {
+        if (hw::pots.pitchGen == gen::PitchMarkov) {     // walks on from step s-1
+            gen::markovRefresh(hw::pots.pitchProb);
+            return gen::markovNext(trPitch.prospectiveSequence[prevStep(s)], random(256));
         }
+        return weightedRandomSelection(8, hw::pots.pitchProb);
+    }
+
+    /* ---- Velocity (gate on/off) --------- */
+    uint8_t genVel(uint8_t s)
+    {
+        if (hw::pots.gateGen == gen::GateEuclid)         // the step's bit of the mask
+            return (gen::euclid(hw::pots.density, hw::pots.euclidRot) >> s) & 1;
+        return random(128) < hw::pots.density;       // 1 = gate present
+    }
+
+    /* ---- Octave displacement – follows the step's new degree ---- */
+    uint8_t genOct(uint8_t s)
+    {
+        uint8_t deg = trPitch.prospectiveSequence[s] & 0x07;
+        return octaveDisplacement(deg) + 1;          // store 0,1,2
+    }
+
+    /* ---- V1 / V2 selector --------------- */
+    uint8_t genAcc(uint8_t s)
+    {
+        if (!trVel.prospectiveSequence[s])           // no gate? → stay Velocity-1
+            return 0;
+        return random(128) < hw::pots.accentChance;  // 1 = Velocity-2
+    }
+
+    uint8_t genGroove(uint8_t)
+    {
+        uint8_t g = uint8_t(uint16_t(random(128)) * hw::pots.nudge >> 10);   // 0-15
+        if (random(128) < hw::pots.ratchetChance) g |= uint8_t(1 + random(3)) << 4;
+        if (random(128) < hw::pots.chordChance)   g |= uint8_t(1 + random(3)) << 6;
+        return g;
+    }
+
+#if LANE_GATE_LEN
+    uint8_t genGate(uint8_t)
+    {
+        uint8_t r = random(8);
+        return r < 4 ? 0 : r - 4;                    // half the time full length
+    }
+#endif
+
+#if LANE_CC
+    uint8_t genCc(uint8_t) { return random(128); }
+
+    void outCc(uint8_t v)
+    {
+        static uint8_t sent = 0xFF;                  // only changes go on the wire
+        if (v == sent) return;
+        voice::control(LANE_CC_NUM, v);              // through the output gate
+        sent = v;
+    }
+#endif
+
+    /* ───────── lane table ───────────────────────────────────────────
+       One row per lane: where its steps live, how a fresh value is
+       drawn, which Δ pot locks it, an optional per-step output, and
+       the value range (home = what a Load leaves in an extra lane).
+       The first four rows are seq::Aspect, in order.  nextStep(),
+       rotation, commit and regeneration all walk this table.        */
+    struct Lane {
+        LaneData* data;
+        uint8_t (*gen)(uint8_t s);
+        void    (*out)(uint8_t v);            // nullptr = read by the note builder
+        uint8_t   delta;                      // index into pots.deltaProb
+        uint8_t   lo, hi, home;               // values lo … hi inclusive
+    };
+
+    const Lane kLanes[] PROGMEM = {
+        { &trPitch,  genPitch,  nullptr, 0, 0, 7,   0 },
+        { &trVel,    genVel,    nullptr, 1, 0, 1,   1 },
+        { &trOct,    genOct,    nullptr, 2, 0, 2,   1 },
+        { &trAcc,    genAcc,    nullptr, 3, 0, 1,   0 },
+        { &trGroove, genGroove, nullptr, 1, 0, 255, 0 },   // timing rides with the gate
+#if LANE_GATE_LEN
+        { &trGate,   genGate,   nullptr, 1, 0, 3,   0 },
+#endif
+#if LANE_CC
+        { &trCc,     genCc,     outCc,   0, 0, 127, 64 },
+#endif
+    };
+    constexpr uint8_t kLaneCount = sizeof kLanes / sizeof kLanes[0];
+    constexpr uint8_t kCoreLanes = (uint8_t)seq::Aspect::Count;
+
+    inline void lane(uint8_t i, Lane& L) { memcpy_P(&L, &kLanes[i], sizeof L); }
+
+    inline uint8_t draw(const Lane& L, uint8_t s) { return constrain(L.gen(s), L.lo, L.hi); }
+
+    /* NoteOff distance for a hit `len` ticks long */
+    inline uint8_t gateTicks(uint8_t len)
+    {
+#if LANE_GATE_LEN
+        uint8_t g = (len * (4 - (trGate.prospectiveSequence[curStep] & 0x03))) >> 2;
+        return g ? g : 1;
+#else
+        return len;
+#endif
     }
 
 }
@@ -102,34 +283,195 @@ uint8_t seq::pitch(uint8_t i){ return trPitch.regularSequence[i]; }
 uint8_t seq::vel  (uint8_t i){ return trVel  .regularSequence[i]; }
 uint8_t seq::oct  (uint8_t i){ return trOct  .regularSequence[i]; }
 uint8_t seq::acc  (uint8_t i){ return trAcc  .regularSequence[i]; }
+bool    seq::pending(uint8_t i){
+    return trPitch.regularSequence[i] != trPitch.prospectiveSequence[i]
+        || trVel  .regularSequence[i] != trVel  .prospectiveSequence[i]
+        || trOct  .regularSequence[i] != trOct  .prospectiveSequence[i]
+        || trAcc  .regularSequence[i] != trAcc  .prospectiveSequence[i];
+}
+
+uint16_t seq::takeChanges(){ uint16_t m = changedSteps; changedSteps = 0; return m; }
 
 void seq::forceStep(uint8_t s){ curStep = s % 16; }
 
+/* ---------- loop range: pots unless a chain entry overrides it ---------- */
+static uint8_t ovStart = 0, ovEnd = 0;       // 0 = follow the pots
+static uint8_t loopCount = 0;
+
+void    seq::setLoopOverride(uint8_t start, uint8_t end){ ovStart = start; ovEnd = end; }
+uint8_t seq::loopStart(){ return ovStart ? ovStart : hw::pots.loopStart; }
+uint8_t seq::loopEnd  (){ return ovStart ? ovEnd   : hw::pots.loopEnd;   }
+uint8_t seq::loops    (){ return loopCount; }
+
 
 /* ---------- init() ---------- */
 void seq::init(){
     for(uint8_t i=0;i<kSteps;i++){
         trPitch.regularSequence[i]=0; trVel.regularSequence[i]=1;
     }
+    changedSteps = 0xFFFF;
+    setQuantize(Action::Reset, Quant::NextStep);     // remote-only, no pot to seed it
 }
 
 /* ===========================================================
-   ❶  Regenerate ALL 16 prospective steps once
+   bulk kernels – whole-lane masks instead of 64 generate() calls
    =========================================================== */
-void seq::regenerateAll(uint8_t probability /*0-127*/)
-{
-    using namespace hw;
+namespace {
 
-    for (uint8_t s = 0; s < kSteps; ++s)
-        for (uint8_t a = 0; a < (uint8_t)Aspect::Count; ++a)
-        {
-            /* Skip this aspect if the Δ-Lock slider says “freeze”.   */
-            if (random(128) < pots.deltaProb[a])
-                continue;
+    /* xorshift16: two usable random bytes per call, no division.
+       Reseeded from random() on every bulk pass, so randomSeed()
+       still controls the sequence.                                */
+    uint16_t rng = 1;
+    inline uint16_t rand16()
+    {
+        rng ^= rng << 7;
+        rng ^= rng >> 9;
+        rng ^= rng << 8;
+        return rng;
+    }
 
-            if (random(128) < probability)          // instChance pot
-                track(Aspect(a)).prospectiveSequence[s] = generate(Aspect(a));
+    /* bit s set ⇔ a fresh 0-127 draw for step s is below p.
+       Same odds as  random(128) < p  for p = 0..128.           */
+    uint16_t coinMask(uint8_t p)
+    {
+        if (p == 0)   return 0;
+        if (p >= 128) return 0xFFFF;
+        uint16_t m = 0;
+        for (uint8_t s = 0; s < kSteps; s += 2) {
+            uint16_t r = rand16();
+            if (( r       & 0x7F) < p) m |= uint16_t(1) << s;
+            if (((r >> 8) & 0x7F) < p) m |= uint16_t(2) << s;
         }
+        return m;
+    }
+
+    /* pitch CDF over the 8 sliders – rebuilt only when a slider moved */
+    uint8_t  cdfSrc[8] = {0};
+    uint16_t pitchCdf[8] = {0};
+
+    void refreshPitchCdf()
+    {
+        if (!memcmp(cdfSrc, hw::pots.pitchProb, sizeof cdfSrc) && pitchCdf[7]) return;
+        memcpy(cdfSrc, hw::pots.pitchProb, sizeof cdfSrc);
+        uint16_t acc = 0;
+        for (uint8_t i = 0; i < 8; ++i) pitchCdf[i] = acc += cdfSrc[i];
+    }
+
+    inline uint8_t drawDegree()
+    {
+        uint16_t total = pitchCdf[7];
+        if (!total) return 0;
+        uint16_t r = (uint32_t(rand16()) * total) >> 16;        // 0 … total-1
+        uint8_t  i = 0;
+        while (r >= pitchCdf[i]) ++i;
+        return i;
+    }
+
+    /* per-degree octave rule, resolved once per pass (see octaveDisplacement) */
+    struct OctRule { uint8_t chance; uint8_t hit; };            // hit = stored 0 / 2
+
+    void octaveRules(OctRule* out)
+    {
+        for (uint8_t d = 0; d < 8; ++d) {
+            uint16_t v = hw::pots.octaveProb[d];
+            if      (v < 62) out[d] = { uint8_t(map(v, 0,63, 127,0)),  0 };
+            else if (v > 64) out[d] = { uint8_t(map(v, 64,127, 0,127)), 2 };
+            else             out[d] = { 0, 1 };
+        }
+    }
+
+    inline uint16_t rowBits(const uint8_t* row)
+    {
+        uint16_t m = 0;
+        for (uint8_t s = 0; s < kSteps; ++s)
+            if (row[s]) m |= uint16_t(1) << s;
+        return m;
+    }
+
+    /* a pass writes lane i's fresh steps into regenRow[i], the steps it
+       touched into regenMask[i]: the live prospect for regenerateAll(),
+       or the idle rows of an Instant prepared ahead of its boundary    */
+    uint8_t* regenRow [kLaneCount];
+    uint16_t regenMask[kLaneCount];
+    bool     prepared = false;           // the idle rows hold a prepared Instant
+
+    void regenerate(uint8_t probability /*0-127*/)
+    {
+        using namespace hw;
+
+        rng = uint16_t(random(1, 65536));      // never 0 – xorshift fixpoint
+
+        uint8_t*  P   = regenRow[(uint8_t)seq::Aspect::Pitch];
+        uint8_t*  V   = regenRow[(uint8_t)seq::Aspect::Vel];
+        uint8_t*  O   = regenRow[(uint8_t)seq::Aspect::Oct];
+        uint8_t*  A   = regenRow[(uint8_t)seq::Aspect::Acc];
+        uint16_t* upd = regenMask;
+
+        /* steps each aspect may touch: not Δ-locked AND passes instChance */
+        for (uint8_t a = 0; a < kCoreLanes; ++a)
+            upd[a] = ~coinMask(pots.deltaProb[a]) & coinMask(probability);
+
+        /* Pitch – degrees from the cached CDF, or a Markov walk along the lane */
+        if (pots.pitchGen == gen::PitchMarkov) {
+            gen::markovRefresh(pots.pitchProb);
+            uint8_t prev = P[kSteps - 1];
+            for (uint8_t s = 0; s < kSteps; ++s) {
+                if (upd[0] & (uint16_t(1) << s))
+                    P[s] = gen::markovNext(prev, uint8_t(rand16()));
+                prev = P[s];
+            }
+        } else {
+            refreshPitchCdf();
+            for (uint8_t s = 0; s < kSteps; ++s)
+                if (upd[0] & (uint16_t(1) << s))
+                    P[s] = drawDegree();
+        }
+
+        /* Vel – 16 gate coins against density in one mask, or the Euclidean mask */
+        uint16_t fresh = pots.gateGen == gen::GateEuclid ? gen::euclid(pots.density, pots.euclidRot)
+                                                         : coinMask(pots.density);
+        uint16_t gates = (rowBits(V) & ~upd[1]) | (fresh & upd[1]);
+
+        /* Oct – follows the (new) prospective degree of each step */
+        OctRule rule[8];
+        octaveRules(rule);
+
+        /* Acc – only where a gate survives */
+        uint16_t accNew = coinMask(pots.accentChance) & gates;
+        uint16_t accent = (rowBits(A) & ~upd[3]) | (accNew & upd[3]);
+
+        for (uint8_t s = 0; s < kSteps; ++s) {
+            uint16_t b = uint16_t(1) << s;
+            V[s] = (gates  & b) ? 1 : 0;
+            A[s] = (accent & b) ? 1 : 0;
+            if (upd[2] & b) {
+                const OctRule& r = rule[P[s] & 0x07];
+                O[s] = ((rand16() & 0x7F) < r.chance) ? r.hit : 1;
+            }
+        }
+
+        /* extra lanes – the very coins of the core lane whose Δ pot they share */
+        for (uint8_t i = kCoreLanes; i < kLaneCount; ++i) {
+            Lane L;  lane(i, L);
+            uint16_t m = upd[L.delta];
+            regenMask[i] = m;
+            for (uint8_t s = 0; s < kSteps; ++s)
+                if (m & (uint16_t(1) << s)) regenRow[i][s] = draw(L, s);
+        }
+    }
+}
+
+/* ===========================================================
+   ❶  Regenerate ALL 16 prospective steps once
+   =========================================================== */
+void seq::regenerateAll(uint8_t probability /*0-127*/)
+{
+    prepared = false;                          // the rows now point at the live lanes
+    for (uint8_t i = 0; i < kLaneCount; ++i) {
+        Lane L;  lane(i, L);
+        regenRow[i] = L.data->prospectiveSequence;
+    }
+    regenerate(probability);
 }
 
 /* ===========================================================
@@ -137,18 +479,30 @@ void seq::regenerateAll(uint8_t probability /*0-127*/)
    =========================================================== */
 void seq::commitProspect()
 {
+    undo::begin();
     for (uint8_t s = 0; s < kSteps; ++s) {
+        if (seq::pending(s)) undo::step(s, seq::packedStep(s));
+        if (trVel.regularSequence[s] != trVel.prospectiveSequence[s] ||
+            trAcc.regularSequence[s] != trAcc.prospectiveSequence[s])
+            markChanged(s);
         trPitch.regularSequence[s] = trPitch.prospectiveSequence[s];
         trVel  .regularSequence[s] = trVel  .prospectiveSequence[s];
         trOct  .regularSequence[s] = trOct  .prospectiveSequence[s];
         trAcc  .regularSequence[s] = trAcc  .prospectiveSequence[s];
     }
+    for (uint8_t i = kCoreLanes; i < kLaneCount; ++i) {
+        Lane L;  lane(i, L);
+        uint8_t* reg = L.data->regularSequence;
+        uint8_t* pro = L.data->prospectiveSequence;
+        for (uint8_t s = 0; s < kSteps; ++s)
+            if (reg[s] != pro[s]) { undo::lane(i - kCoreLanes, s, reg[s]); reg[s] = pro[s]; }
+    }
 }
 
 /* ===============================================================
    rotation helpers – work on BOTH regular + prospect arrays
    =============================================================== */
-static void rotateLeft (Track& T)
+static void rotateLeft (LaneData& T)
 {
     uint8_t first = T.regularSequence[0];
     for (uint8_t i = 0; i < kSteps-1; ++i)
@@ -161,7 +515,7 @@ static void rotateLeft (Track& T)
     T.prospectiveSequence[kSteps-1] = first;
 }
 
-static void rotateRight(Track& T)
+static void rotateRight(LaneData& T)
 {
     uint8_t last = T.regularSequence[kSteps-1];
     for (int8_t i = kSteps-1; i > 0; --i)
@@ -177,104 +531,374 @@ static void rotateRight(Track& T)
 /* public wrappers ------------------------------------------------ */
 void seq::rotateAllLeft ()
 {
-    rotateLeft (trPitch); rotateLeft (trVel);
-    rotateLeft (trOct  ); rotateLeft (trAcc);
+    for (uint8_t i = 0; i < kLaneCount; ++i) { Lane L; lane(i, L); rotateLeft (*L.data); }
+    changedSteps = 0xFFFF;
+    prepared     = false;                 // its masks no longer line up
 }
 
 void seq::rotateAllRight()
 {
-    rotateRight(trPitch); rotateRight(trVel);
-    rotateRight(trOct  ); rotateRight(trAcc);
+    for (uint8_t i = 0; i < kLaneCount; ++i) { Lane L; lane(i, L); rotateRight(*L.data); }
+    changedSteps = 0xFFFF;
+    prepared     = false;
 }
 
-static bool resetPending = false;
-void  seq::armReset() { resetPending = true; }
+/* ===============================================================
+   action scheduler – a tiny FIFO of (action, boundary) pairs
+   =============================================================== */
+namespace {
+    constexpr uint8_t kMaxQueued = 8;
 
-/* ---------- nextStep() – main logic ---------- */
-void seq::nextStep()
-{
-    MIDI.sendControlChange(123,0,1);             // all notes off
-    
-    using namespace hw;
+    struct Pending { seq::Action act; seq::Quant at; };
 
-    /* 0. honour pending reset ------------------------------------ */
-    if (resetPending) {
-        curStep      = hw::pots.loopStart ? hw::pots.loopStart - 1 : 0;
-        resetPending = false;           // one-shot
-    } else {
-    /* 1. advance step counter normally ----------------------- */
-    curStep = advanceWithin(curStep,
-                            hw::pots.loopStart - 1,
-                            hw::pots.loopEnd   - 1);
-}
+    /* performance actions keep their setting in a hw::Param, so CC and
+       SysEx reach it (RotateL/R, Commit, Instant, Reset); the rest are
+       internal and fixed here                                          */
+    uint8_t* quantParam(seq::Action a)
+    {
+        switch (a) {
+            case seq::Action::RotateLeft:
+            case seq::Action::RotateRight: return &hw::pots.quantRotate;
+            case seq::Action::Commit:      return &hw::pots.quantCommit;
+            case seq::Action::Instant:     return &hw::pots.quantInstant;
+            case seq::Action::Reset:       return &hw::pots.quantReset;
+            default:                       return nullptr;
+        }
+    }
+    seq::Quant quant[(uint8_t)seq::Action::Count] = {
+        seq::Quant::Immediate,    // RotateLeft   } hw::pots.quant…
+        seq::Quant::Immediate,    // RotateRight  }
+        seq::Quant::Immediate,    // Commit       }
+        seq::Quant::Immediate,    // Instant      }
+        seq::Quant::NextStep,     // Reset        }
+        seq::Quant::NextStep,     // Load  (staged pattern lands on a step)
+        seq::Quant::NextStep,     // Undo
+        seq::Quant::NextStep      // Redo
+    };
+    Pending queue[kMaxQueued];
+    uint8_t queued = 0;
 
-    /* 2. loop over four aspects */
-    for(uint8_t a=0; a < (uint8_t)Aspect::Count; ++a)
+    bool resetDue = false;        // set by apply(Reset), read by nextStep()
+
+    bool    stagedValid = false;
+    uint8_t stagedLoop[2] = {0, 0};   // loop range that comes with it (0 = keep)
+    uint8_t loadCount   = 0;
+    void  (*stagedHook)() = nullptr;  // runs inside the swap (staged params)
+
+    void loadStaged()
     {
-        Aspect asp = (Aspect)a;
-        Track& T   = track(asp);
-
-        /* ─ Δ-lock ─ */
-        bool delta = (random(128) < pots.deltaProb[a]);
-        if (delta){
-            T.prospectiveSequence[curStep] = T.regularSequence[curStep];
-            hw::btnInstant.edge = false;
-            continue;
+        if (!stagedValid) return;
+        trPitch.swap(); trVel.swap(); trOct.swap(); trAcc.swap();   // O(1)
+        for (uint8_t i = kCoreLanes; i < kLaneCount; ++i) {         // not in the format
+            Lane L;  lane(i, L);
+            memset(L.data->regularSequence,     L.home, kSteps);
+            memset(L.data->prospectiveSequence, L.home, kSteps);
         }
+        if (stagedLoop[0]) seq::setLoopOverride(stagedLoop[0], stagedLoop[1]);
+        if (stagedHook) { stagedHook(); stagedHook = nullptr; }
+        undo::clear();                              // old deltas, old pattern
+        stagedValid  = false;
+        changedSteps = 0xFFFF;
+        ++loadCount;
+    }
 
-        /* ─ Instantaneous (highest priority) ─ */
-        if (btnInstant.edge && random(128) < pots.instChance){
-            uint8_t v = generate(asp);
-            T.regularSequence [curStep] = v;
-            T.prospectiveSequence[curStep] = v;
+    /* an Instant queued for a later boundary draws its values now, into
+       the idle rows; the boundary only merges them and commits.  The
+       idle bank may hold a staged Load – then it is drawn at the edge. */
+    void prepareInstant()
+    {
+        prepared = false;
+        if (stagedValid) return;
+        for (uint8_t i = 0; i < kLaneCount; ++i) {
+            Lane L;  lane(i, L);
+            regenRow[i] = L.data->spare;
+            memcpy(regenRow[i], L.data->prospectiveSequence, kSteps);
+        }
+        regenerate(hw::pots.instChance);
+        prepared = true;
+    }
 
-            hw::btnInstant.edge = false;
-            continue;
+    void mergePrepared()
+    {
+        for (uint8_t i = 0; i < kLaneCount; ++i) {
+            Lane L;  lane(i, L);
+            uint8_t* pro = L.data->prospectiveSequence;
+            for (uint8_t s = 0; s < kSteps; ++s)
+                if (regenMask[i] & (uint16_t(1) << s)) pro[s] = regenRow[i][s];
         }
+        prepared = false;
+    }
 
-        /* ─ Destructive ─ */
-        if (btnDestruct.level && random(128) < pots.destructiveChance){
-            uint8_t v = generate(asp);
-
-                //debug
-                /*Serial.print(F("Vel = ["));
-                for (uint8_t i=0;i<16;i++){ Serial.print(trVel.regularSequence[i]); Serial.print(' '); }
-                Serial.println(']');*/
-            
-            T.regularSequence [curStep] = v;
-            T.prospectiveSequence[curStep] = v;
-            continue;
+    void apply(seq::Action a)
+    {
+        switch (a) {
+            case seq::Action::RotateLeft:  seq::rotateAllLeft();  undo::rotate(true);  break;
+            case seq::Action::RotateRight: seq::rotateAllRight(); undo::rotate(false); break;
+            case seq::Action::Commit:      seq::commitProspect(); break;
+            case seq::Action::Instant:
+                if (prepared) mergePrepared();             // drawn when it was queued
+                else          seq::regenerateAll(hw::pots.instChance);
+                seq::commitProspect();
+                break;
+            case seq::Action::Reset:       resetDue = true;       break;
+            case seq::Action::Load:        loadStaged();          break;
+            case seq::Action::Undo:        undo::undo();          break;
+            case seq::Action::Redo:        undo::redo();          break;
+            default: break;
         }
+    }
 
-        /* ─ Nondestructive ─ */
-        if (random(128) < pots.nondestChance){
-            T.prospectiveSequence[curStep] = generate(asp);
-            continue;
+    /* run every queued action whose boundary is in `due` (bit per Quant),
+       in press order, and drop it from the queue                       */
+    void applyDue(uint8_t due)
+    {
+        uint8_t keep = 0;
+        for (uint8_t i = 0; i < queued; ++i) {
+            if (due & (1 << (uint8_t)queue[i].at)) apply(queue[i].act);
+            else                                    queue[keep++] = queue[i];
         }
+        queued = keep;
+    }
+}
 
-        /* ─ default: copy regular → prospect ─ */
-        T.prospectiveSequence[curStep] = T.regularSequence[curStep];
+void seq::setQuantize(Action a, Quant q)
+{
+    if (a >= Action::Count) return;
+    if (uint8_t* p = quantParam(a)) *p = (uint8_t)q;
+    else                            quant[(uint8_t)a] = q;
+}
+seq::Quant seq::quantize(Action a)
+{
+    uint8_t* p = quantParam(a);
+    return p ? Quant(min(*p, (uint8_t)Quant::NextBar)) : quant[(uint8_t)a];
+}
+
+uint8_t seq::packedStep(uint8_t s)
+{
+    s &= 0x0F;
+    return (trPitch.regularSequence[s] & 0x07)
+         | (trVel  .regularSequence[s] ? 0x08 : 0)
+         | ((trOct .regularSequence[s] & 0x03) << 4)
+         | (trAcc  .regularSequence[s] ? 0x40 : 0);
+}
+
+uint8_t seq::packedProspect(uint8_t s)
+{
+    s &= 0x0F;
+    return (trPitch.prospectiveSequence[s] & 0x07)
+         | (trVel  .prospectiveSequence[s] ? 0x08 : 0)
+         | ((trOct .prospectiveSequence[s] & 0x03) << 4)
+         | (trAcc  .prospectiveSequence[s] ? 0x40 : 0);
+}
+
+void seq::setPackedStep(uint8_t s, uint8_t b)
+{
+    s &= 0x0F;
+    trPitch.regularSequence[s] = trPitch.prospectiveSequence[s] =  b       & 0x07;
+    trVel  .regularSequence[s] = trVel  .prospectiveSequence[s] = (b >> 3) & 0x01;
+    trOct  .regularSequence[s] = trOct  .prospectiveSequence[s] = (b >> 4) & 0x03;
+    trAcc  .regularSequence[s] = trAcc  .prospectiveSequence[s] = (b >> 6) & 0x01;
+    markChanged(s);
+}
+
+void seq::exportPattern(uint8_t* packed)
+{
+    for (uint8_t s = 0; s < kSteps; ++s) packed[s] = packedStep(s);
+}
+
+/* decode straight into the idle bank – Load only swaps pointers */
+void seq::stageStep(uint8_t s, uint8_t b, bool prospect)
+{
+    s &= 0x0F;
+    uint8_t side = prospect ? 1 : 0;
+    stagedValid = false;                          // half-written until commitStage()
+    prepared    = false;                          // shares the idle bank
+    trPitch.bank[trPitch.live ^ 1][side][s] =  b       & 0x07;
+    trVel  .bank[trVel  .live ^ 1][side][s] = (b >> 3) & 0x01;
+    trOct  .bank[trOct  .live ^ 1][side][s] = (b >> 4) & 0x03;
+    trAcc  .bank[trAcc  .live ^ 1][side][s] = (b >> 6) & 0x01;
+}
+
+void seq::commitStage(void (*onLoad)())
+{
+    stagedLoop[0] = stagedLoop[1] = 0;
+    stagedHook  = onLoad;
+    stagedValid = true;
+}
+
+void seq::stagePattern(const uint8_t* packed)
+{
+    for (uint8_t s = 0; s < kSteps; ++s) {
+        stageStep(s, packed[s], false);
+        stageStep(s, packed[s], true);
     }
+    commitStage();
+}
 
+void seq::stageLoop(uint8_t start, uint8_t end)
+{
+    stagedLoop[0] = start;
+    stagedLoop[1] = end;
+}
 
-    /* 4. Build and send MIDI note (simple demo) */
-    static const uint8_t modes[7][8] = {
-        {0,2,4,5,7,9,11,12},   // Ionian
-        {0,2,3,5,7,9,10,12},   // Dorian
-        {0,1,3,5,7,8,10,12},   // Phrygian
-        {0,2,4,6,7,9,11,12},   // Lydian
-        {0,2,4,5,7,9,10,12},   // Mixolydian
-        {0,2,3,5,7,8,10,12},   // Aeolian
-        {0,1,3,5,6,8,10,12}    // Locrian
-    };
+uint8_t seq::loads(){ return loadCount; }
+
+bool seq::hasStaged(){ return stagedValid; }
+
+uint8_t seq::extraLanes() { return kLaneCount - kCoreLanes; }
+
+uint8_t seq::laneValue(uint8_t l, uint8_t s)
+{
+    if (l >= extraLanes()) return 0;
+    Lane L;  lane(kCoreLanes + l, L);
+    return L.data->regularSequence[s & 0x0F];
+}
+
+uint8_t seq::laneProspect(uint8_t l, uint8_t s)
+{
+    if (l >= extraLanes()) return 0;
+    Lane L;  lane(kCoreLanes + l, L);
+    return L.data->prospectiveSequence[s & 0x0F];
+}
+
+void seq::setLaneValue(uint8_t l, uint8_t s, uint8_t v)
+{
+    if (l >= extraLanes()) return;
+    Lane L;  lane(kCoreLanes + l, L);
+    s &= 0x0F;
+    L.data->regularSequence[s] = L.data->prospectiveSequence[s] = constrain(v, L.lo, L.hi);
+    markChanged(s);
+}
 
-    //Set pitch
+void seq::setLaneProspect(uint8_t l, uint8_t s, uint8_t v)
+{
+    if (l >= extraLanes()) return;
+    Lane L;  lane(kCoreLanes + l, L);
+    s &= 0x0F;
+    L.data->prospectiveSequence[s] = constrain(v, L.lo, L.hi);
+    markChanged(s);
+}
+
+void seq::dropStaged()
+{
+    stagedValid   = false;
+    stagedHook    = nullptr;
+    stagedLoop[0] = stagedLoop[1] = 0;
+}
+
+void seq::schedule(Action a)
+{
+    if (a < Action::Count) scheduleAt(a, quantize(a));
+}
+
+void seq::scheduleAt(Action a, Quant q)
+{
+    if (a >= Action::Count) return;
+    if (q == Quant::Immediate) { apply(a); return; }
+    if (queued >= kMaxQueued) return;
+    queue[queued++] = { a, q };
+    if (a == Action::Instant) prepareInstant();   // the heavy part, off the edge
+}
+
+void seq::cancel(Action a)
+{
+    uint8_t keep = 0;
+    for (uint8_t i = 0; i < queued; ++i)
+        if (queue[i].act != a) queue[keep++] = queue[i];
+    queued = keep;
+    if (a == Action::Instant) prepared = false;
+}
+
+/* same step, same degree/octave – only the table under it moved */
+void seq::repitch()
+{
+    if (!soundVel) return;                       // rest: nothing to move
+    refreshPitchTable();
+    uint8_t to[kMaxVoices];
+    uint8_t n = 0;
+    for (; n < kMaxVoices; ++n) {                  // every new pitch first …
+        uint8_t st = pgm_read_byte(&kChords[soundChord][n]);
+        if (st == 0xFF) break;
+        to[n] = chordPitch(soundDeg, soundOct, st);
+    }
+    wheel::retarget(soundPitch, to, n, soundVel);  // … then the chord moves as one
+    memcpy(soundPitch, to, n);
+}
+
+/* ---------- nextStep() – main logic ---------- */
+void seq::nextStep()
+{
+    using namespace hw;
+
+    /* 0. where would we land, and which boundaries does that cross? */
+    uint8_t loopA = seq::loopStart() - 1;
+    uint8_t next  = advanceWithin(curStep, loopA, seq::loopEnd() - 1);
+
+    uint8_t due = 1 << (uint8_t)Quant::NextStep;
+    if (next == loopA) {
+        due |= 1 << (uint8_t)Quant::LoopStart;
+        ++loopCount;
+        undo::seal();                   // one live undo group per loop pass
+    }
+
+    uint8_t bar = clock::bars();            // first step on / after a bar line
+    if (bar != lastBar) {
+        lastBar = bar;
+        due |= 1 << (uint8_t)Quant::NextBar;
+    }
+
+    /* 1. apply quantised actions atomically, then advance ---------- */
+    if (queued) applyDue(due);
+
+    if (resetDue || (next == loopA && seq::loopStart() - 1 != loopA)) {
+        /* reset, or a load at the loop seam brought its own range */
+        curStep  = seq::loopStart() ? seq::loopStart() - 1 : 0;
+        resetDue = false;               // one-shot
+    } else {
+        curStep  = next;
+    }
+
+    /* 2. one pass over the lane table – same rules for every lane.
+          One Δ-lock roll per Δ pot, shared by every lane it locks. */
+    uint8_t locked = 0;
+    for (uint8_t a = 0; a < kCoreLanes; ++a)
+        if (random(128) < pots.deltaProb[a]) locked |= 1 << a;
+
+    uint8_t before = packedStep(curStep);       // for the undo log
+    bool    wrote  = false;
+    for (uint8_t i = 0; i < kLaneCount; ++i)
+    {
+        Lane L;  lane(i, L);
+        uint8_t* reg = L.data->regularSequence;
+        uint8_t* pro = L.data->prospectiveSequence;
+
+        if (locked & (1 << L.delta)) {                               /* ─ Δ-lock ─ */
+            pro[curStep] = reg[curStep];
+        }
+        else if (btnDestruct.level && random(128) < pots.destructiveChance) {  /* ─ Destructive ─ */
+            uint8_t old = reg[curStep];
+            reg[curStep] = pro[curStep] = draw(L, curStep);
+            markChanged(curStep);
+            if (i < kCoreLanes)                wrote = true;
+            else if (reg[curStep] != old)      undo::laneLive(i - kCoreLanes, curStep, old);
+        }
+        else if (random(128) < pots.nondestChance) {                 /* ─ Nondestructive ─ */
+            pro[curStep] = draw(L, curStep);
+        }
+        else {                                                       /* ─ copy regular → prospect ─ */
+            pro[curStep] = reg[curStep];
+        }
+
+        if (L.out) L.out(pro[curStep]);
+    }
+    if (wrote && packedStep(curStep) != before) undo::live(curStep, before);
+
+
+    /* 4. Build and send MIDI note – one lookup in the cached table */
+    refreshPitchTable();
     uint8_t degree = trPitch.prospectiveSequence[curStep] & 0x07;          // 0-7
-    uint8_t scale  = constrain(pots.scale, 1, 7) - 1;       // 0-6
-    int8_t octDisp = int8_t(trOct.prospectiveSequence[curStep]) - 1;     // 0,1,2 → -1..+1
-    uint8_t midiPitch = pots.root
-                    + modes[scale][degree]
-                    + octDisp * 12;
+    uint8_t octIx  = trOct.prospectiveSequence[curStep];                    // 0,1,2 → -1..+1
+    if (octIx > 2) octIx = 1;
 
 
     //Set velocity/accent
@@ -290,11 +914,37 @@ void seq::nextStep()
 
 
 
-    MIDI.sendNoteOn(midiPitch, midiVel, 1);      // new note
+    /* 5. queue the hit(s) on the tick wheel: swing on odd steps, the
+          step's nudge, and ratchets splitting the step evenly.  The
+          NoteOffs are queued with them, so no per-step all-notes-off.
+          Hits share what is left of the step after the delay, so the
+          last NoteOff lands by the next step's tick and never cuts a
+          NoteOn of the same pitch there.
+          A chord queues every voice per hit; chords ratchet at most
+          twice, which keeps a step inside the wheel's fixed pool.   */
+    uint8_t pps   = constrain(pots.pulsesPerStep, 1, 24);
+    uint8_t g     = trGroove.prospectiveSequence[curStep];
+    uint8_t chord = g >> 6;
+    uint8_t delay = ((curStep & 1) ? uint16_t(pots.swing) * pps >> 8 : 0)   // < ½ step
+                  + (uint16_t(g & 0x0F) * pps >> 5);                        // < ½ step
+    uint8_t span  = pps - delay;                                            // ≥ 1
+    uint8_t hits  = 1 + ((g >> 4) & 0x03);
+    if (chord && hits > 2) hits = 2;
+    if (hits > span) hits = span;
+    uint8_t len   = span / hits;
+    uint8_t gate  = gateTicks(len);
+
+    soundDeg = degree; soundOct = octIx; soundVel = midiVel; soundChord = chord;
+    for (uint8_t v = 0; v < kMaxVoices; ++v) {
+        uint8_t st = pgm_read_byte(&kChords[chord][v]);
+        if (st == 0xFF) break;
+        soundPitch[v] = chordPitch(degree, octIx, st);
+        if (midiVel)
+            for (uint8_t k = 0; k < hits; ++k)
+                wheel::note(delay + k * len, gate, soundPitch[v], midiVel, v);
+    }
     ui::refresh();          // draw into the pixel buffer
-    strip.show();           // commit: interrupts off for 0.4 ms
-
-    hw::btnInstant.edge = false;    // prevents multiple hits per press
+    ui::commit();           // one batched show, only if something moved
 
     //TESTING
     //Serial.print(F("STEP ")); Serial.println(curStep);
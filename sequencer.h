@@ -2,8 +2,14 @@
 #include <Arduino.h>
 #include "hw_inputs.h"      // for pots + buttons
 
+/* optional lanes – 0 compiles the lane out (32 bytes of RAM each) */
+#define LANE_GATE_LEN  1        // per-step gate length, full … ¼ step
+#define LANE_CC        0        // per-step value sent as CC LANE_CC_NUM
+#define LANE_CC_NUM    74       //   (74 = brightness / filter cutoff)
+
 namespace seq {
 
+    /* the four core lanes – the packed step format, in lane-table order */
     enum class Aspect : uint8_t { Pitch, Vel, Oct, Acc, Count }; //Dbl
 
     void init();
@@ -13,12 +19,71 @@ namespace seq {
     void commitProspect();
     void rotateAllLeft();
     void rotateAllRight();
-    void armReset();
+
+    /* ── quantised performance actions ─────────────────────────────
+       Buttons schedule() an action; the step engine applies everything
+       that is due atomically at the top of nextStep(), before the note
+       is built.  Each action carries its own quantise setting – the
+       performance ones live in hw::pots.quant… (CC / SysEx).  NextBar
+       follows the clock's bar lines (clock::bars()), not a step count.
+       A queued Instant is drawn when it is scheduled; the boundary
+       only merges it in.                                              */
+    enum class Action : uint8_t { RotateLeft, RotateRight, Commit, Instant, Reset, Load,
+                                  Undo, Redo, Count };
+    enum class Quant  : uint8_t { Immediate, NextStep, LoopStart, NextBar };
+
+    void  setQuantize(Action a, Quant q);
+    Quant quantize(Action a);
+    void  schedule(Action a);        // applies now or queues for its boundary
+
+    /* ── packed patterns ───────────────────────────────────────────
+       One byte per step, 7-bit clean:
+         bit 0-2 degree · bit 3 gate · bit 4-5 octave (0,1,2) · bit 6 accent
+       A staged pattern is swapped in by Action::Load.                 */
+    constexpr uint8_t kPackedLen = 16;
+
+    uint8_t packedStep   (uint8_t i);             // regular step i, packed
+    uint8_t packedProspect(uint8_t i);            // prospective step i, packed
+    void    setPackedStep(uint8_t i, uint8_t b);  // regular + prospect ← b
+    void    exportPattern(uint8_t* packed);       // regular → 16 packed steps
+    void    stagePattern (const uint8_t* packed); // decode into the idle bank
+    void    stageStep    (uint8_t i, uint8_t packed, bool prospect);  // one at a time …
+    void    commitStage  (void (*onLoad)() = nullptr);   // … then arm; onLoad runs in the swap
+    void    stageLoop    (uint8_t start, uint8_t end);   // range to switch with it
+    bool    hasStaged();
+    void    dropStaged();                         // forget it (and its loop range)
+    uint8_t loads();                              // bumps on every Load swap
+
+    /* extra lanes (groove, gate length, CC) – outside the packed step;
+       a Load resets them to their home value, then its onLoad hook may
+       write them (a SysEx dump carries groove and gate length).       */
+    constexpr uint8_t kLaneGroove = 0;            // extraLanes() index
+    constexpr uint8_t kLaneGate   = 1;            //   … LANE_GATE_LEN builds
+    uint8_t extraLanes();
+    uint8_t laneValue      (uint8_t lane, uint8_t s);              // regular
+    uint8_t laneProspect   (uint8_t lane, uint8_t s);
+    void    setLaneValue   (uint8_t lane, uint8_t s, uint8_t v);   // regular + prospect
+    void    setLaneProspect(uint8_t lane, uint8_t s, uint8_t v);   // prospect only
+
+    void    scheduleAt(Action a, Quant q);        // one-off quantise override
+    void    cancel    (Action a);                 // drop it from the queue
+
+    /* loop range (1-16) – the pots, unless overridden (chain mode) */
+    void    setLoopOverride(uint8_t start, uint8_t end);   // 0,0 = pots
+    uint8_t loopStart();
+    uint8_t loopEnd();
+    uint8_t loops();                              // bumps at every loop wrap
 
     /* expose read-only state for UI */
     uint8_t stepNow();               // 0-15
+    void    repitch();               // re-sound the current note at the new root/scale
     uint8_t pitch(uint8_t i);        // helpers
     uint8_t vel  (uint8_t i);
     uint8_t oct  (uint8_t i);
     uint8_t acc  (uint8_t i);
+    bool    pending(uint8_t i);      // prospect differs from regular at step i
+
+    /* steps whose regular data changed since the last call (bit i = step i).
+       Reading clears the mask – the UI is the only consumer. */
+    uint16_t takeChanges();
 }
@@ -0,0 +1,283 @@
+/*  sysex.cpp  ────────────────────────────────────────────────────────────
+    SysEx dump / load – no frame buffers, just two small state machines
+    ---------------------------------------------------------------------- */
+
+#include "sysex.h"
+#include "sequencer.h"
+#include "hw_inputs.h"
+#include "voices.h"
+#include "scales.h"
+#include <stddef.h>
+#include <avr/pgmspace.h>
+
+namespace {
+
+    constexpr uint8_t MFR_ID   = 0x7D;    // non-commercial / educational
+    constexpr uint8_t DEV_ID   = 0x51;    // 'Q'
+    constexpr uint8_t CMD_REQ  = 0x01;
+    constexpr uint8_t CMD_DUMP = 0x02;
+    constexpr uint8_t CMD_SCALE = 0x03;         // user scale: 8 ascending offsets
+    constexpr uint8_t CMD_CHAIN = 0x04;         // one song / chain entry
+    constexpr uint8_t kChainLen = 5;            // index slot repeats start end
+    constexpr uint8_t VERSION  = 0x07;          // 2: + swing, nudge, ratchet  3: + chord
+                                                // 4: + generator modes  5: + quantise
+                                                // 6: + key follow  7: + groove / gate lanes
+
+    /* parameter block: byte offset into hw::PotValues (layout-proof) and
+       the Param that range-checks it on load.  DERIVED bytes go out as
+       they are and come back through their owner (bpm → pulsesPerStep). */
+    struct Field { uint8_t off, param; };
+    constexpr uint8_t DERIVED = 0xFF;
+    #define QM_P(f, p)      { uint8_t(offsetof(hw::PotValues, f)), uint8_t(hw::Param::p) }
+    #define QM_PA(f, i, p)  { uint8_t(offsetof(hw::PotValues, f) + (i)), uint8_t(uint8_t(hw::Param::p) + (i)) }
+    #define QM_PD(f, i)     { uint8_t(offsetof(hw::PotValues, f) + (i)), DERIVED }
+    const Field kParamMap[] PROGMEM = {
+        QM_P(loopStart, LoopStart), QM_P(loopEnd, LoopEnd), QM_P(root, Root), QM_P(scale, Scale),
+        QM_P(velocity, Velocity),   QM_P(accentVel, AccentVel), QM_P(density, Density),
+        QM_P(destructiveChance, Destructive), QM_P(nondestChance, Nondest),
+        QM_P(instChance, Instant),  QM_P(accentChance, AccentChance), QM_PD(pulsesPerStep, 0),
+        QM_P(bpm, Tempo), QM_PD(bpm, 1),                            // low byte first
+        QM_PA(pitchProb, 0, PitchProb0), QM_PA(pitchProb, 1, PitchProb0),
+        QM_PA(pitchProb, 2, PitchProb0), QM_PA(pitchProb, 3, PitchProb0),
+        QM_PA(pitchProb, 4, PitchProb0), QM_PA(pitchProb, 5, PitchProb0),
+        QM_PA(pitchProb, 6, PitchProb0), QM_PA(pitchProb, 7, PitchProb0),
+        QM_PA(octaveProb, 0, OctProb0), QM_PA(octaveProb, 1, OctProb0),
+        QM_PA(octaveProb, 2, OctProb0), QM_PA(octaveProb, 3, OctProb0),
+        QM_PA(octaveProb, 4, OctProb0), QM_PA(octaveProb, 5, OctProb0),
+        QM_PA(octaveProb, 6, OctProb0), QM_PA(octaveProb, 7, OctProb0),
+        QM_PA(deltaProb, 0, DeltaPitch), QM_PA(deltaProb, 1, DeltaPitch),
+        QM_PA(deltaProb, 2, DeltaPitch), QM_PA(deltaProb, 3, DeltaPitch),
+        QM_P(swing, Swing), QM_P(nudge, Nudge), QM_P(ratchetChance, Ratchet), QM_P(chordChance, Chord),
+        QM_P(pitchGen, PitchGen), QM_P(gateGen, GateGen), QM_P(euclidRot, EuclidRot),
+        QM_P(quantRotate, QuantRotate), QM_P(quantCommit, QuantCommit),
+        QM_P(quantInstant, QuantInstant), QM_P(quantReset, QuantReset),
+        QM_P(keyChannel, KeyChannel), QM_P(keyScale, KeyScale), QM_P(keyRepitch, KeyRepitch),
+    };                                  // chainMode, ccChannel: setup, not pattern
+    #undef QM_P
+    #undef QM_PA
+    #undef QM_PD
+
+    constexpr uint8_t kParams    = sizeof kParamMap / sizeof kParamMap[0];
+    constexpr uint8_t kSteps2    = 2 * 16;                      // regular + prospect
+    constexpr uint8_t kGate      = kSteps2;                     // lane block: groove, then
+    constexpr uint8_t kLaneBytes = kSteps2 + 16;                //   gate regular | prospect << 2
+    constexpr uint8_t kWide      = kParams + kLaneBytes;        // 8-bit bytes, 7-in-8 on the wire
+    constexpr uint8_t kGroups    = (kWide + 6) / 7;             // 7 raw → 8 wire
+    constexpr uint8_t kPayload   = kSteps2 + kGroups * 8;
+    constexpr uint8_t kHeader    = 5;                           // F0 id dev cmd ver
+    constexpr uint8_t kFrame     = kHeader + kPayload + 2;      // + sum + F7
+
+    inline uint8_t* potByte(uint8_t i)
+    {
+        return reinterpret_cast<uint8_t*>(&hw::pots) + pgm_read_byte(&kParamMap[i].off);
+    }
+
+    /* ───────── receive ────────────────────────────────────────────── */
+    uint8_t stagedParams[kParams];        // the parameter half of the double buffer
+    uint8_t rxSteps [kSteps2];            // frame being received – nothing else is
+    uint8_t rxParams[kParams];            //   touched until its checksum passes
+    uint8_t lanes[kLaneBytes];            // groove / gate – received in place, see below
+    bool    lanesValid = false;           // lanes[] is the staged frame's, untouched since
+    void  (*chainHandler)(const uint8_t*) = nullptr;
+    uint8_t rxPos  = 0;                   // bytes accepted so far (0 = idle)
+    uint8_t rxCmd  = 0;
+    uint8_t rxSum  = 0;
+    uint8_t rxMsbs = 0;                   // top bits of the current 7-byte group
+    bool    rxDone = false;               // sum matched, waiting for F7
+
+    /* runs inside the step-boundary swap.  Every field goes through the
+       Param table, so a hostile or stale frame is clamped to its range
+       (loopStart 0 would index outside the step arrays).              */
+    void applyParams()
+    {
+        for (uint8_t i = 0; i < kParams; ++i) {
+            uint8_t p = pgm_read_byte(&kParamMap[i].param);
+            if (p == DERIVED) continue;
+            int16_t v = stagedParams[i];
+            if (p == (uint8_t)hw::Param::Tempo) v |= int16_t(stagedParams[i + 1]) << 8;
+            hw::setParamValue(hw::Param(p), v);
+        }
+        hw::holdAll();                    // pots pick the values up (soft takeover)
+
+        if (!lanesValid) return;          // overwritten by a bad frame: lanes stay home
+        lanesValid = false;
+        for (uint8_t s = 0; s < 16; ++s) {
+            seq::setLaneValue   (seq::kLaneGroove, s, lanes[s]);
+            seq::setLaneProspect(seq::kLaneGroove, s, lanes[16 + s]);
+#if LANE_GATE_LEN
+            seq::setLaneValue   (seq::kLaneGate, s,  lanes[kGate + s]       & 0x03);
+            seq::setLaneProspect(seq::kLaneGate, s, (lanes[kGate + s] >> 2) & 0x03);
+#endif
+        }
+    }
+
+    /* wide byte i of an outgoing dump: parameter block, then lanes */
+    uint8_t wideByte(uint8_t i)
+    {
+        if (i < kParams) return *potByte(i);
+        i -= kParams;
+        if (i < 16)      return seq::laneValue   (seq::kLaneGroove, i);
+        if (i < kSteps2) return seq::laneProspect(seq::kLaneGroove, i - 16);
+#if LANE_GATE_LEN
+        i -= kGate;
+        return seq::laneValue(seq::kLaneGate, i) | seq::laneProspect(seq::kLaneGate, i) << 2;
+#else
+        return 0;                                       // full length
+#endif
+    }
+
+    /* payload bytes per command; 0 = no payload, no checksum */
+    uint8_t payloadLen(uint8_t cmd)
+    {
+        switch (cmd) {
+            case CMD_DUMP:  return kPayload;
+            case CMD_SCALE: return scale::kDegrees;
+            case CMD_CHAIN: return kChainLen;
+            default:        return 0;
+        }
+    }
+
+    void payloadByte(uint8_t k, uint8_t b)
+    {
+        if (k < kSteps2) { rxSteps[k] = b; return; }    // packed step as is / short frame
+        k -= kSteps2;
+        uint8_t g = k >> 3, pos = k & 7;
+        if (pos == 0) { rxMsbs = b; return; }           // group header
+        uint8_t i = g * 7 + pos - 1;
+        b |= ((rxMsbs >> (pos - 1)) & 1) << 7;
+        if (i < kParams) { rxParams[i] = b; return; }
+        /* no scratch copy for the lanes (48 B of SRAM): they land in
+           place, and a pending Load whose lanes were overwritten by a
+           frame that then failed its checksum leaves them at home     */
+        lanesValid = false;
+        if (i < kWide) lanes[i - kParams] = b;
+    }
+
+    /* a checked user scale: taken only if it really ascends */
+    void applyScale()
+    {
+        for (uint8_t d = 1; d < scale::kDegrees; ++d)
+            if (rxSteps[d] <= rxSteps[d - 1]) return;
+        scale::setUser(rxSteps);                        // pitch table follows revision()
+    }
+
+    /* a whole, checked frame → the idle bank + staged params */
+    void stageFrame()
+    {
+        for (uint8_t k = 0; k < kSteps2; ++k) seq::stageStep(k & 0x0F, rxSteps[k], k >= 16);
+        memcpy(stagedParams, rxParams, kParams);
+        lanesValid = true;
+        seq::commitStage(applyParams);                  // swap on next step
+        seq::schedule(seq::Action::Load);
+    }
+
+    /* ───────── transmit – bytes generated on demand ───────────────── */
+    uint8_t txPos = kFrame;               // == kFrame ⇒ idle
+    uint8_t txSum = 0;
+    bool    txWanted = false;
+
+    uint8_t wideWire(uint8_t k)
+    {
+        uint8_t g = k >> 3, pos = k & 7;
+        if (pos == 0) {
+            uint8_t msbs = 0;
+            for (uint8_t n = 0; n < 7; ++n) {
+                uint8_t i = g * 7 + n;
+                if (i < kWide && (wideByte(i) & 0x80)) msbs |= 1 << n;
+            }
+            return msbs;
+        }
+        uint8_t i = g * 7 + pos - 1;
+        return i < kWide ? (wideByte(i) & 0x7F) : 0;
+    }
+
+    uint8_t txByte(uint8_t i)
+    {
+        switch (i) {
+            case 0: return 0xF0;
+            case 1: return MFR_ID;
+            case 2: return DEV_ID;
+            case 3: return CMD_DUMP;
+            case 4: return VERSION;
+        }
+        if (i == kFrame - 1) return 0xF7;
+        if (i == kFrame - 2) return (-txSum) & 0x7F;
+        uint8_t k = i - kHeader;
+        uint8_t b = k < 16      ? seq::packedStep(k)
+                  : k < kSteps2 ? seq::packedProspect(k - 16)
+                                : wideWire(k - kSteps2);
+        txSum += b;
+        return b;
+    }
+}
+
+/* ───────── feed() – one byte, constant work ──────────────────────────
+   Sees every byte MIDI.read() takes off the UART (midi_port.h).       */
+void sysex::feed(uint8_t b)
+{
+    if (b >= 0xF8) return;                               // real-time may interleave
+    if (b == 0xF0) { rxPos = 1; rxSum = 0; rxDone = false; return; }
+    if (!rxPos) return;                                  // not ours / aborted
+
+    if (b == 0xF7) {
+        if (rxDone && rxCmd == CMD_DUMP) {
+            stageFrame();
+        } else if (rxDone && rxCmd == CMD_SCALE) {
+            applyScale();
+        } else if (rxDone && rxCmd == CMD_CHAIN) {
+            if (chainHandler) chainHandler(rxSteps);
+        } else if (rxCmd == CMD_REQ && rxPos == kHeader) {
+            sendDump();
+        }
+        rxPos = 0;
+        return;
+    }
+    if (b & 0x80 || rxDone) { rxPos = 0; return; }       // stray status / overlong
+
+    switch (rxPos) {
+        case 1: if (b != MFR_ID)  rxPos = 0; else ++rxPos; return;
+        case 2: if (b != DEV_ID)  rxPos = 0; else ++rxPos; return;
+        case 3: rxCmd = b; ++rxPos;                        return;
+        case 4: if (b != VERSION) rxPos = 0; else ++rxPos; return;
+    }
+    uint8_t len = payloadLen(rxCmd);
+    if (!len) { rxPos = 0; return; }
+
+    uint8_t k = rxPos - kHeader;
+    if (k == len) {                                      // checksum byte
+        if (((rxSum + b) & 0x7F) == 0) rxDone = true; else rxPos = 0;
+        return;
+    }
+    rxSum += b;
+    payloadByte(k, b);
+    ++rxPos;
+}
+
+void sysex::setChainHandler(void (*fn)(const uint8_t*)) { chainHandler = fn; }
+
+/* ───────── send – never blocks on the UART ──────────────────────────
+   A dump may not be split by channel messages.  The voices are the one
+   writer of those and hold their burst while sending() – notes come
+   out late (~25 ms at most) rather than inside the frame.            */
+void sysex::sendDump() { txWanted = true; }
+
+bool sysex::sending() { return txPos < kFrame; }
+
+void sysex::service()
+{
+    if (txWanted && txPos >= kFrame) {
+        txWanted = false;
+        txPos    = 0;
+        txSum    = 0;
+    }
+
+    while (txPos < kFrame && Serial.availableForWrite() > 0)
+        Serial.write(txByte(txPos++));
+
+    if (txPos >= kFrame) voice::send();           // whatever the voices held back
+}
+
+void sysex::finish()
+{
+    while (txPos < kFrame) Serial.write(txByte(txPos++));   // rare: blocks on a full UART
+}
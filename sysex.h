@@ -0,0 +1,31 @@
+#pragma once
+#include <Arduino.h>
+
+/*  sysex.h  ──────────────────────────────────────────────────────────────
+    Bulk dump / load of the engine over SysEx:
+      F0 7D 51 <cmd> <ver> <payload…> <sum> F7
+    cmd 01 = dump request (host → box), 02 = dump (either way),
+    03 = user scale (host → box): 8 ascending semitone offsets, the
+    scale pot's top position plays it.  04 = one chain entry (host →
+    box): <index> <slot> <repeats> <loopStart> <loopEnd>, handed to the
+    registered handler once its checksum passes (see chain::program).
+    Payload = 16 regular + 16 prospective packed steps (already 7-bit,
+    one step per byte) followed, in 7-in-8 form, by the parameter block
+    and the extra lanes: 16 + 16 groove bytes, then 16 gate-length bytes
+    (regular | prospect << 2; 0 = full step when the lane is built out).
+    The CC lane (LANE_CC) is not carried – a load resets it to home.
+    Loads are parsed byte by byte as MIDI.read() takes them off the UART,
+    into a scratch frame; only a frame whose checksum passes is copied
+    into the sequencer's idle bank and a staged parameter copy, then
+    swapped in on the next step.
+    ---------------------------------------------------------------------- */
+
+namespace sysex {
+
+    void feed(uint8_t b);                 // incremental parser, every RX byte
+    void setChainHandler(void (*fn)(const uint8_t* entry));   // cmd 04 payload
+    void sendDump();                      // start a dump (non-blocking)
+    void service();                       // call each loop(): trickle dump bytes
+    bool sending();                       // a dump is in flight – voices hold notes
+    void finish();                        // the rest of it now (blocks; last resort)
+}
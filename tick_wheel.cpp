@@ -0,0 +1,129 @@
+/*  tick_wheel.cpp  ───────────────────────────────────────────────────────
+    Per-tick note scheduler (see tick_wheel.h)
+    ---------------------------------------------------------------------- */
+
+#include "tick_wheel.h"
+#include "voices.h"
+
+namespace {
+
+    constexpr uint8_t kPool = 32;         // a 4-note chord × 2 hits × on/off, ×2 steps
+    constexpr uint8_t NIL   = 0xFF;
+    constexpr uint8_t MASK  = wheel::kHorizon - 1;
+    static_assert((wheel::kHorizon & MASK) == 0, "horizon must be a power of two");
+
+    struct Ev {
+        uint8_t  next;                    // pool index, NIL = end of slot list
+        uint16_t pitch : 7;
+        uint16_t vel   : 7;               // 0 = NoteOff
+        uint16_t tone  : 2;               // chord tone, see retarget()
+    };
+    static_assert(wheel::kTones <= 4, "tone is a 2-bit field");
+
+    Ev      pool[kPool];
+    uint8_t slot[wheel::kHorizon];        // list head per tick
+    uint8_t freeList = NIL;
+    uint8_t freeCount = 0;
+    uint8_t now = 0;                      // slot the next tick() sends
+    uint8_t lag = 0;                      // ticks played but not sent (output held)
+
+    void push(uint8_t at, uint8_t pitch, uint8_t vel, uint8_t tone)
+    {
+        uint8_t i = freeList;
+        freeList  = pool[i].next;
+        --freeCount;
+        at = (now + at) & MASK;
+        pool[i].next  = slot[at];
+        pool[i].pitch = pitch & 0x7F;
+        pool[i].vel   = vel   & 0x7F;
+        pool[i].tone  = tone  & 0x03;
+        slot[at] = i;
+    }
+
+    inline void release(uint8_t i)
+    {
+        pool[i].next = freeList;
+        freeList = i;
+        ++freeCount;
+    }
+
+    /* offs first, then ons: a hit that ends on the tick the next one
+       starts never cuts the new note of the same pitch                 */
+    void sendSlot()
+    {
+        uint8_t head = slot[now];
+        slot[now] = NIL;
+        now = (now + 1) & MASK;
+        if (head == NIL) return;
+
+        for (uint8_t i = head; i != NIL; i = pool[i].next)
+            if (!pool[i].vel) voice::off(pool[i].pitch);
+
+        for (uint8_t i = head; i != NIL; ) {
+            uint8_t n = pool[i].next;
+            if (pool[i].vel) voice::on(pool[i].pitch, pool[i].vel);
+            release(i);
+            i = n;
+        }
+    }
+}
+
+void wheel::init()
+{
+    memset(slot, NIL, sizeof slot);
+    freeList = NIL;
+    freeCount = 0;
+    for (uint8_t i = 0; i < kPool; ++i) release(i);
+    now = 0;
+    lag = 0;
+}
+
+bool wheel::note(uint8_t delay, uint8_t len, uint8_t pitch, uint8_t vel, uint8_t tone)
+{
+    if (freeCount < 2 || !vel || uint16_t(lag) + delay + len >= kHorizon) return false;
+    push(lag + delay + len, pitch, 0,   tone);
+    push(lag + delay,       pitch, vel, tone);
+    return true;
+}
+
+/* a dump holds the notes back at most half the wheel, then finishes */
+void wheel::tick()
+{
+    ++lag;
+    if (voice::held() && lag < kHorizon / 2) return;
+    for (; lag; --lag) sendSlot();
+    voice::sendNow();                     // the whole tick in one write
+}
+
+void wheel::flush()
+{
+    for (uint8_t t = 0; t < kHorizon; ++t) {
+        for (uint8_t i = slot[t]; i != NIL; ) {
+            uint8_t n = pool[i].next;
+            release(i);
+            i = n;
+        }
+        slot[t] = NIL;
+    }
+    lag = 0;
+    voice::allOff();                      // the voices know what is sounding
+}
+
+/* one pass over the wheel: an event moves once, by its tone.  A queued
+   NoteOff holds a voice reference unless its NoteOn is still queued
+   too, so refs[k] = offs − ons moved for tone k.                      */
+void wheel::retarget(const uint8_t* from, const uint8_t* to, uint8_t n, uint8_t vel)
+{
+    int8_t refs[kTones] = {};
+    if (n > kTones) n = kTones;
+    for (uint8_t t = 0; t < kHorizon; ++t)
+        for (uint8_t i = slot[t]; i != NIL; i = pool[i].next) {
+            uint8_t k = pool[i].tone;
+            if (k >= n || pool[i].pitch != from[k] || from[k] == to[k]) continue;
+            pool[i].pitch = to[k];
+            refs[k] += pool[i].vel ? -1 : 1;
+        }
+    uint8_t held[kTones];
+    for (uint8_t k = 0; k < n; ++k) held[k] = refs[k] > 0 ? refs[k] : 0;
+    voice::move(from, to, held, n, vel);
+}
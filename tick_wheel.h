@@ -0,0 +1,38 @@
+#pragma once
+#include <Arduino.h>
+
+/*  tick_wheel.h  ─────────────────────────────────────────────────────────
+    Timing wheel for note events, one slot per MIDI clock (24 PPQN).
+    nextStep() schedules the step's NoteOn/NoteOff pairs up to
+    kHorizon ticks ahead (swing, nudge, ratchets), and the clock
+    calls tick() on every pulse to send what is due.  A tick only
+    walks its own slot, so its cost depends on the events due then,
+    not on how many are queued.
+    While the voices hold the UART for a SysEx dump, ticks keep counting
+    but their slots wait; the first tick after it sends them in order.
+    ---------------------------------------------------------------------- */
+
+namespace wheel {
+
+    constexpr uint8_t kHorizon = 64;      // ticks ahead; power of two
+    constexpr uint8_t kTones   = 4;       // chord tones a hit can be tagged with
+
+    void init();
+
+    /* one hit: NoteOn after `delay` ticks, NoteOff `len` ticks later.
+       Both are queued or neither is, so a full pool drops the hit and
+       never leaves a note hanging.  delay + len < kHorizon, counted
+       from the tick being played, not the one last sent.  `tone` is the
+       chord tone the hit belongs to (0 … kTones-1), for retarget().   */
+    bool note(uint8_t delay, uint8_t len, uint8_t pitch, uint8_t vel, uint8_t tone = 0);
+
+    void tick();                          // this tick's events → voices, advance
+    void flush();                         // stop: NoteOffs now, drop NoteOns
+
+    /* live transpose of a whole chord at once: every queued event of
+       tone k (still at from[k]) moves to to[k], and the voices follow
+       with exactly the references those events hold.  All new pitches
+       are known up front, so a tone moving onto another tone's old
+       pitch never merges with it.                                     */
+    void retarget(const uint8_t* from, const uint8_t* to, uint8_t n, uint8_t vel);
+}
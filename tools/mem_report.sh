@@ -0,0 +1,73 @@
+#!/bin/sh
+#  mem_report.sh  ─────────────────────────────────────────────────────────
+#  Per-module SRAM report for the AVR build, and a headroom gate.
+#
+#    tools/mem_report.sh [fqbn] [min-free-bytes]
+#
+#  Builds the sketch with arduino-cli (plus -fstack-usage, and -fno-lto:
+#  LTO objects hold only .gnu.lto_* sections and their .su files are
+#  written for the link-time partitions, not per object), then prints
+#  .data / .bss per object – every .data.<sym> / .bss.<sym> section that
+#  -fdata-sections splits off counted – for sketch modules, libraries
+#  (MIDI, NeoPixel) and the Arduino core (HardwareSerial's ring buffers)
+#  alike, and the deepest single stack frame each module declares.  The
+#  totals are those of the non-LTO link, a little above the LTO build.
+#  Exits 1 when  SRAM − (.data + .bss) − heap − stack reserve  drops
+#  below min-free-bytes, so it can sit in front of an upload or in CI.
+#  The heap is NeoPixel's pixel buffer, malloc'd in begin(); its size is
+#  read from NUM_LEDS in ui.cpp.  The stack reserve is an estimate (no
+#  run-time measurement backs it) – override it with STACK_RESERVE.
+#  ------------------------------------------------------------------------
+
+FQBN=${1:-arduino:avr:nano}
+MIN_FREE=${2:-256}
+SRAM=${SRAM:-2048}                 # ATmega328P
+STACK_RESERVE=${STACK_RESERVE:-192}   # estimate: ISR frames + deepest call chain
+
+SKETCH=$(cd "$(dirname "$0")/.." && pwd)
+BUILD=${BUILD:-$(mktemp -d)}
+
+AVR_SIZE=${AVR_SIZE:-$(command -v avr-size || \
+    ls "$HOME"/.arduino15/packages/arduino/tools/avr-gcc/*/bin/avr-size 2>/dev/null | tail -n 1)}
+[ -x "$AVR_SIZE" ] || { echo "avr-size not found (set AVR_SIZE)"; exit 2; }
+
+arduino-cli compile -b "$FQBN" --build-path "$BUILD" \
+    --build-property "compiler.c.extra_flags=-fno-lto -fstack-usage" \
+    --build-property "compiler.cpp.extra_flags=-fno-lto -fstack-usage" \
+    "$SKETCH" > "$BUILD/compile.log" 2>&1 || { cat "$BUILD/compile.log"; exit 2; }
+
+NUM_LEDS=$(sed -n 's/.*NUM_LEDS *= *\([0-9][0-9]*\).*/\1/p' "$SKETCH/ui.cpp" | head -n 1)
+BPP=3; grep -q 'NEO_[RGBW]*W' "$SKETCH/ui.cpp" && BPP=4
+HEAP=${HEAP:-$(( ${NUM_LEDS:-0} * BPP + 2 ))}   # pixel buffer + malloc header
+
+# .data / .bss of one object or the ELF, split sections summed
+ram() { "$AVR_SIZE" -A "$1" | awk '
+    $1 ~ /^\.data(\.|$)/ { d += $2 }
+    $1 ~ /^\.bss(\.|$)/  { b += $2 }
+    END { print d+0, b+0 }'; }
+
+MAXFR=0
+printf '%-28s %6s %6s %7s\n' module .data .bss "frame"
+for o in "$BUILD"/sketch/*.o "$BUILD"/libraries/*/*.o "$BUILD"/libraries/*/*/*.o \
+         "$BUILD"/core/*.o; do
+    [ -f "$o" ] || continue
+    m=$(basename "$o" .o)
+    set -- $(ram "$o")
+    su="${o%.o}.su"
+    fr=$( [ -f "$su" ] && awk -F'\t' '$2+0 > m { m = $2+0 } END { print m+0 }' "$su" || echo -)
+    [ "$fr" != - ] && [ "$fr" -gt "$MAXFR" ] && MAXFR=$fr
+    [ "$1" = 0 ] && [ "$2" = 0 ] && [ "$fr" = 0 ] && continue
+    printf '%-28s %6s %6s %7s\n' "$m" "$1" "$2" "$fr"
+done
+
+ELF=$(ls "$BUILD"/*.elf | head -n 1)
+set -- $(ram "$ELF")
+USED=$(( $1 + $2 ))
+FREE=$(( SRAM - USED - HEAP - STACK_RESERVE ))
+printf '\nstatic RAM %d / %d bytes, heap %d, stack reserve %d (estimate), headroom %d (min %d)\n' \
+    "$USED" "$SRAM" "$HEAP" "$STACK_RESERVE" "$FREE" "$MIN_FREE"
+
+[ "$STACK_RESERVE" -ge "$MAXFR" ] || \
+    echo "WARN: stack reserve $STACK_RESERVE is below the deepest single frame ($MAXFR)"
+
+[ "$FREE" -ge "$MIN_FREE" ] || { echo "FAIL: SRAM headroom below $MIN_FREE bytes"; exit 1; }
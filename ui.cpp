@@ -11,20 +11,11 @@ Adafruit_NeoPixel strip(NUM_LEDS, LED_PIN, NEO_GRB + NEO_KHZ800);
 
 /* ───────── cached previous state ───── */
 static uint8_t  prevStep      = 255;      // invalid → forces first paint
-static uint8_t  prevLoopMin   = 0;
-static uint8_t  prevLoopMax   = 0;
-static uint8_t  prevVel[NUM_LEDS] = {0};
+static uint8_t  prevLoopStart = 0;        // raw pot values, 0 = never seen
+static uint8_t  prevLoopEnd   = 0;
 
 static bool ledsDirty = false;           // set → something changed this frame
-
-/* quick helpers */
-inline void px(uint8_t i,uint8_t r,uint8_t g,uint8_t b){
-    uint32_t newClr = strip.Color(r,g,b);
-    if (strip.getPixelColor(i) != newClr) {   // only if color actually changes
-        strip.setPixelColor(i,newClr);
-        ledsDirty = true;                     // request a strip.show()
-    }
-}
+static bool ledsUrgent = false;          // a band change – show without waiting
 
 /* colour palette (tweak to taste) */
 struct RGB { uint8_t r,g,b; };
@@ -78,29 +69,80 @@ static inline RGB heatColor(uint8_t vel)
     return base;
 }
 
-/* Helpers used everywhere else in ui.cpp */
-inline RGB colour_v1() { return heatColor(hw::pots.velocity ); }
-inline RGB colour_v2() { return heatColor(hw::pots.accentVel); }
-
-
+/* ───────── palette LUT + per-pixel class cache ─────────────────────
+   Every pixel is classified once into a PixType; the strip colour is then
+   a single table lookup.  Paint and erase share the same cache, and the
+   heat entries are only rebuilt when the Velocity / Acc_amt pots move.  */
+constexpr bool GAMMA_LUT = false;       // ← true = run palette through gamma8()
+
+enum PixType : uint8_t {
+    PT_OFF, PT_V1, PT_V2, PT_MARK_ST, PT_MARK_END, PT_OUTSIDE,   // static band
+    PT_HEAD_LOOP, PT_HEAD_GEN, PT_HEAD_INST, PT_HEAD_DEST,      // play-head
+    PT_DEG0,                                 // + 0..7  scale degree hues
+    PT_OCT_DN = PT_DEG0 + 8, PT_OCT_MID, PT_OCT_UP,
+    PT_DIFF_SAME, PT_DIFF_NEW,
+    PT_PROB0,                                // + 0..7  pot heat levels
+    PT_COUNT = PT_PROB0 + 8
+};
+
+constexpr uint8_t N_PAGES = (uint8_t)ui::Page::Count;
+constexpr uint8_t SWEEP_BUDGET = 4;     // background pixels classified per frame
+
+static RGB      palette[PT_COUNT];      // strip colours, 3 bytes (not 4) each
+static uint8_t  frame  [N_PAGES][NUM_LEDS];   // cached class of every pixel, per page
+static uint8_t  shown  [NUM_LEDS];      // palette index last written (255 = unknown)
+static uint8_t  curPage = 0;            // ui::Page currently on the strip
+constexpr uint8_t PT_GATE_PAGE = (uint8_t)ui::Page::Gate;
+
+static inline RGB pack(RGB c)
+{
+    if (GAMMA_LUT)
+        return { Adafruit_NeoPixel::gamma8(c.r),
+                 Adafruit_NeoPixel::gamma8(c.g),
+                 Adafruit_NeoPixel::gamma8(c.b) };
+    return c;
+}
 
-inline void flashLed(uint8_t ledIdx, RGB colour, uint8_t frames=4)
+static void buildStaticPalette()
 {
-    static uint8_t timer[8]={0};
-    if (ledIdx>=8) return;
-    timer[ledIdx] = frames;
-    px(ledIdx, colour.r, colour.g, colour.b);
-    // count-down in refresh() tail
-    for(uint8_t i=0;i<8;i++){
-        if(timer[i] && --timer[i]==0) px(i,0,0,0);
+    palette[PT_OFF]       = pack(CLR_OFF);
+    palette[PT_MARK_ST]   = pack(CLR_MARK_ST);
+    palette[PT_MARK_END]  = pack(CLR_MARK_END);
+    palette[PT_OUTSIDE]   = pack(CLR_OUTSIDE);
+    palette[PT_HEAD_LOOP] = pack(CLR_PLAY_LOOP);
+    palette[PT_HEAD_GEN]  = pack(CLR_PLAY_GEN);
+    palette[PT_HEAD_INST] = pack({60,60, 0});     // yellow flash
+    palette[PT_HEAD_DEST] = pack({60, 0, 0});     // red flash
+
+    for (uint8_t d = 0; d < 8; ++d) {               // degree → hue, dimmed
+        RGB c = wheel(d * 32);
+        palette[PT_DEG0 + d] = pack({uint8_t(c.r / 4), uint8_t(c.g / 4), uint8_t(c.b / 4)});
     }
+    palette[PT_OCT_DN]    = pack({ 0, 10, 60});     // blue  = down
+    palette[PT_OCT_MID]   = pack({12, 12,  8});     // dim   = centre
+    palette[PT_OCT_UP]    = pack({60, 10,  0});     // red   = up
+    palette[PT_DIFF_SAME] = pack({ 6,  6,  4});     // gate, unchanged
+    palette[PT_DIFF_NEW]  = pack({70, 30,  0});     // amber = prospect differs
+
+    for (uint8_t l = 0; l < 8; ++l)                 // 8 heat steps, once at boot
+        palette[PT_PROB0 + l] = pack(heatColor(l * 16 + 15));
+}
+
+/* the only place heatColor() runs – once per pot move, not per pixel */
+static void buildHeatPalette(uint8_t v1, uint8_t v2)
+{
+    palette[PT_V1] = pack(heatColor(v1));
+    palette[PT_V2] = pack(heatColor(v2));
 }
 
 /* ───────────────────────────────────── */
 void ui::init(){
+    buildStaticPalette();
+    memset(shown, 255, sizeof shown);
     strip.begin();
     strip.setBrightness(50);
-    strip.show();                 // clear
+    ledsDirty = true;             // clear, through the one show path
+    commit();
 }
 
 /* ── marker helpers ───────────────────────────────────────────────
@@ -108,8 +150,8 @@ void ui::init(){
 
 inline int8_t markerStartIx()      /* dim-magenta */
 {
-    uint8_t s = hw::pots.loopStart ? hw::pots.loopStart-1 : 0;
-    uint8_t e = hw::pots.loopEnd   ? hw::pots.loopEnd  -1 : 0;
+    uint8_t s = seq::loopStart() ? seq::loopStart()-1 : 0;
+    uint8_t e = seq::loopEnd()   ? seq::loopEnd()  -1 : 0;
     bool wrap = s > e;
 
     if (!wrap && s == 0) return -1;            // hide when start = 1
@@ -119,8 +161,8 @@ inline int8_t markerStartIx()      /* dim-magenta */
 
 inline int8_t markerEndIx()        /* dim-white  */
 {
-    uint8_t s = hw::pots.loopStart ? hw::pots.loopStart-1 : 0;
-    uint8_t e = hw::pots.loopEnd   ? hw::pots.loopEnd  -1 : 0;
+    uint8_t s = seq::loopStart() ? seq::loopStart()-1 : 0;
+    uint8_t e = seq::loopEnd()   ? seq::loopEnd()  -1 : 0;
     bool wrap = s > e;
 
     if (!wrap && e == 15) return -1;           // hide when end = 16
@@ -128,144 +170,171 @@ inline int8_t markerEndIx()        /* dim-white  */
                 : (e + 1)  & 0x0F;             // one AFTER otherwise
 }
 
-static void paintStaticRegion()
+/* loop band, cached whenever the loop pots move */
+static uint8_t bandLo = 0, bandHi = 15;
+static int8_t  bandSt = -1, bandEnd = -1;
+
+static inline uint8_t probLevel(uint8_t v) { return v > 127 ? 7 : v >> 4; }
+
+static uint8_t classify(uint8_t pg, uint8_t i)
 {
-    /* loop range */
-    uint8_t lo = hw::pots.loopStart-1;        // 0-15
-    uint8_t hi = hw::pots.loopEnd  -1;
-    if (lo > hi) { uint8_t tmp = lo; lo = hi; hi = tmp; }
-
-    /*for(uint8_t i=0;i<NUM_LEDS;i++){
-        RGB c = (i<lo || i>hi) ? CLR_OUTSIDE
-                               : (seq::vel(i)? CLR_INSIDE : CLR_OFF);
-        px(i,c.r,c.g,c.b);
-        prevVel[i] = seq::vel(i);
-    }*/
-
-    int8_t ixSt  = markerStartIx();
-    int8_t ixEnd = markerEndIx();
-
-    for (uint8_t i = 0; i < NUM_LEDS; ++i) {
-        RGB c;
-        if (i == ixSt) {                 // marker BEFORE start
-            c = CLR_MARK_ST;
-        } else if (i == ixEnd) {            // marker AFTER end
-            c = CLR_MARK_END;
-        } else if (i < lo || i > hi) {        // completely outside
-            c = CLR_OUTSIDE;
-        } else if (seq::vel(i)) {             // gate present?
-            c = seq::acc(i) ? colour_v2()     // Velocity-2 hit (yellow, scaled)
-                            : colour_v1();    // Velocity-1 hit (green,  scaled)
-        } else {                              // rest
-            c = CLR_OFF;
+    if ((ui::Page)pg == ui::Page::Prob)                    // not a step view
+        return PT_PROB0 + probLevel(i < 8 ? hw::pots.pitchProb [i]
+                                          : hw::pots.octaveProb[i - 8]);
+
+    if (i == bandSt)                return PT_MARK_ST;     // marker BEFORE start
+    if (i == bandEnd)               return PT_MARK_END;    // marker AFTER end
+    if (i < bandLo || i > bandHi)   return PT_OUTSIDE;     // completely outside
+
+    switch ((ui::Page)pg) {
+        case ui::Page::Degree: {                           // what will play
+            uint8_t b = seq::packedProspect(i);
+            return (b & 0x08) ? PT_DEG0 + (b & 0x07) : PT_OFF;
+        }
+        case ui::Page::Octave: {
+            uint8_t b = seq::packedProspect(i), o = (b >> 4) & 0x03;
+            return (b & 0x08) ? PT_OCT_DN + (o > 2 ? 1 : o) : PT_OFF;
         }
-        px(i, c.r, c.g, c.b);
+        case ui::Page::Diff:
+            if (seq::pending(i)) return PT_DIFF_NEW;
+            return seq::vel(i) ? PT_DIFF_SAME : PT_OFF;
+        default:
+            if (!seq::vel(i))       return PT_OFF;         // rest
+            return seq::acc(i) ? PT_V2 : PT_V1;            // Velocity-2 / -1 hit
+    }
+}
+
+/* reclassify the pixels named in mask; returns those whose class changed */
+static uint16_t classifyMask(uint8_t pg, uint16_t mask)
+{
+    uint16_t moved = 0;
+    for (uint8_t i = 0; mask; ++i, mask >>= 1) {
+        if (!(mask & 1)) continue;
+        uint8_t t = classify(pg, i);
+        if (t != frame[pg][i]) { frame[pg][i] = t; moved |= uint16_t(1) << i; }
+    }
+    return moved;
+}
 
-        uint8_t type = 0;                          // 0 = off/rest
-        if      (i == ixSt)  type = 3;             // magenta marker
-        else if (i == ixEnd) type = 4;             // white   marker
-        else if (seq::vel(i)) type = seq::acc(i) ? 2 : 1;
-        prevVel[i] = type;
+/* background sweep – a fixed number of (page, pixel) slots per frame keeps
+   every cached page fresh without ever blowing the per-loop budget      */
+static uint16_t sweep()
+{
+    static uint8_t cursor = 0;            // page * NUM_LEDS + pixel
+    uint16_t moved = 0;
+    for (uint8_t n = 0; n < SWEEP_BUDGET; ++n) {
+        uint8_t pg = cursor / NUM_LEDS, i = cursor % NUM_LEDS;
+        if (pg != (uint8_t)ui::Page::Gate) {      // Gate is change-mask driven
+            uint8_t t = classify(pg, i);
+            if (t != frame[pg][i]) {
+                frame[pg][i] = t;
+                if (pg == curPage) moved |= uint16_t(1) << i;
+            }
+        }
+        if (++cursor >= N_PAGES * NUM_LEDS) cursor = 0;
     }
+    return moved;
+}
+
+void ui::commit(bool idle)
+{
+    if (!ledsDirty) return;
+    /* external sync: from loop() only a band change goes out at once;
+       the rest waits for the step edge, a gap we know is safe       */
+    if (idle && clock::usingExt && !ledsUrgent) return;
+    strip.show();                 // interrupts off for ~0.5 ms
+    ledsDirty  = false;
+    ledsUrgent = false;
+}
 
-    prevLoopMin = lo;
-    prevLoopMax = hi;
+void ui::setPage(Page p)
+{
+    if ((uint8_t)p >= N_PAGES) p = Page::Gate;
+    curPage = (uint8_t)p;          // refresh() diffs the cached frame in
 }
+void ui::nextPage()    { setPage(Page((curPage + 1) % N_PAGES)); }
+ui::Page ui::page()    { return (Page)curPage; }
 
 void ui::refresh()
 {
     //if (clock::usingExt) return;      // ❶ DON’T touch LEDs while external sync is active
-    /* flash on edges ------------------------------------------------ */
-//if(hw::btnCycleL.edge) flashLed(3, {0,60,0});       // green
-//if(hw::btnCycleR.edge) flashLed(5, {0,60,0});
-//if(hw::btnReset .edge) flashLed(4, {0, 0,60});      // blue
 
-    bool needFull = false;
+    uint16_t dirty = 0;                  // pixels that must be re-resolved
 
+    /* 1. heat palette – rebuilt only when the velocity pots move ── */
     static uint8_t prevPotV1 = 255, prevPotV2 = 255;
     if (hw::pots.velocity  != prevPotV1 ||
         hw::pots.accentVel != prevPotV2) {
-        needFull  = true;
         prevPotV1 = hw::pots.velocity;
         prevPotV2 = hw::pots.accentVel;
+        buildHeatPalette(prevPotV1, prevPotV2);
+        memset(shown, 255, sizeof shown);          // same index, new colour
+        dirty = 0xFFFF;
     }
 
-    /* 1. detect whether static region must be repainted ── */
-    uint8_t lo = hw::pots.loopStart - 1;
-    uint8_t hi = hw::pots.loopEnd   - 1;
-    if (lo > hi) { uint8_t t = lo; lo = hi; hi = t; }   // swap for reverse
-
-    if (lo != prevLoopMin || hi != prevLoopMax) {
-        needFull = true;                 /* pots moved → repaint band   */
-    } else {
-        for (uint8_t i = 0; i < NUM_LEDS; ++i) {
-            uint8_t nowType = seq::vel(i) ? (seq::acc(i) ? 2 : 1) : 0;
-            if (nowType != prevVel[i]) { needFull = true; break; }
-        }
+    /* 2. loop band – markers depend on direction, so track raw pots ── */
+    bool bandMoved = seq::loopStart() != prevLoopStart ||
+                     seq::loopEnd()   != prevLoopEnd;
+    if (bandMoved) {
+        prevLoopStart = seq::loopStart();
+        prevLoopEnd   = seq::loopEnd();
+        bandLo  = seq::loopStart() - 1;          // 0-15
+        bandHi  = seq::loopEnd()   - 1;
+        if (bandLo > bandHi) { uint8_t t = bandLo; bandLo = bandHi; bandHi = t; }
+        bandSt  = markerStartIx();
+        bandEnd = markerEndIx();
     }
-    if (needFull) {
-        paintStaticRegion();
-        prevStep = 255;                  /* force head redraw too      */
-        ledsDirty = true;
 
-        strip.show();                 // one 0.4 ms block – happens rarely
-        ledsDirty = false;            // buffer is now clean
-    }
+    /* 3. sequencer change mask – no per-frame scan of all 16 steps ── */
+    uint16_t changed = seq::takeChanges();
+    if (bandMoved) changed = 0xFFFF;
+    uint16_t moved = changed ? classifyMask(PT_GATE_PAGE, changed) : 0;
+    if (curPage == PT_GATE_PAGE) dirty |= moved;
 
-    /* 2. head / play-cursor ───────────────────────────────── */
-    uint8_t step = seq::stepNow();           // 0-15
-    bool oneStepLoop = (prevLoopMin == prevLoopMax);
-
-    if (needFull || step != prevStep || oneStepLoop) {
-        /* erase old -------- */
-        if (prevStep < NUM_LEDS) {
-            uint8_t i = prevStep;
-            int8_t ixSt  = markerStartIx();
-            int8_t ixEnd = markerEndIx();
-
-            RGB c;
-            if (i == ixSt) {                   // magenta marker
-                c = CLR_MARK_ST;
-            } else if (i == ixEnd) {         // white marker
-                c = CLR_MARK_END;
-            } else if (i < prevLoopMin || i > prevLoopMax) {
-                c = CLR_OUTSIDE;
-            } else if (seq::vel(i)) {
-                c = seq::acc(i) ? colour_v2()                  // Velocity-2 (yellow, scaled)
-                                : colour_v1();                 // Velocity-1 (green,  scaled)
-            } else {                                           // rest
-                c = CLR_OFF;
-            }
-            px(i, c.r, c.g, c.b);
-            uint8_t type = 0;                    // 0 = off/rest
-            if      (i == ixSt)      type = 3;   // magenta marker
-            else if (i == ixEnd)     type = 4;   // white   marker
-            else if (seq::vel(i))    type = seq::acc(i) ? 2 : 1;
-            prevVel[i] = type;
-        }
+    /* the visible page is never allowed to lag a band move */
+    if (bandMoved && curPage != PT_GATE_PAGE) dirty |= classifyMask(curPage, 0xFFFF);
+    dirty |= sweep();
 
-        /* draw new -------- */
-        RGB head = seq::vel(step) ? CLR_PLAY_LOOP : CLR_PLAY_GEN;
-        if (hw::btnInstant.edge)       head = {60,60, 0};   // yellow flash
-        else if (hw::btnDestruct.edge) head = {60, 0, 0};   // red flash
-        px(step, head.r, head.g, head.b);
+    /* page switch: the frame is already cached – just diff it in */
+    static uint8_t prevPage = 0;
+    if (curPage != prevPage) { prevPage = curPage; dirty = 0xFFFF; }
 
-        prevStep = step;
+    /* 4. head / play-cursor ───────────────────────────────── */
+    uint8_t step = seq::stepNow();           // 0-15
+    bool    showHead = curPage != (uint8_t)Page::Prob;
+    uint8_t head = (frame[PT_GATE_PAGE][step] == PT_V1 ||
+                    frame[PT_GATE_PAGE][step] == PT_V2)
+                 ? PT_HEAD_LOOP : PT_HEAD_GEN;
+
+    /* Instant / Destruct presses tint the head until it moves on */
+    static hw::EventReader buttons;
+    static uint8_t headFlash = 0;
+    hw::BtnEvent ev;
+    while (hw::nextEvent(buttons, ev)) {
+        if (!ev.press) continue;
+        if      (ev.btn == hw::Btn::Instant)  headFlash = PT_HEAD_INST;   // yellow
+        else if (ev.btn == hw::Btn::Destruct) headFlash = PT_HEAD_DEST;   // red
     }
 
-    /* ---------- commit to strip ---------- */
-    if (ledsDirty) {
-
-        if (!clock::usingExt) {
-            /* internal-clock mode – safe to block right now */
-            strip.show();
-            ledsDirty = false;
-        }
-        else {
-            /* external sync: defer the blocking call until the exact
-               instant a new step has *already* arrived → we piggy-back
-               on the gap we know is safe (Option 1 throttle).           */
+    if (step != prevStep) {
+        if (prevStep < NUM_LEDS) dirty |= uint16_t(1) << prevStep;   // erase old
+        prevStep  = step;
+        headFlash = 0;
+    }
+    if (headFlash) head = headFlash;
+    if (showHead && shown[step] != head) dirty |= uint16_t(1) << step;   // draw new
+
+    /* 5. dirty-span render – nothing dirty ⇒ nothing to do ───── */
+    for (uint8_t i = 0; dirty; ++i, dirty >>= 1) {
+        if (!(dirty & 1)) continue;
+        uint8_t ix = (showHead && i == step) ? head : frame[curPage][i];
+        if (shown[i] != ix) {
+            strip.setPixelColor(i, palette[ix].r, palette[ix].g, palette[ix].b);
+            shown[i]  = ix;
+            ledsDirty = true;
         }
     }
-}
 
+    /* a band change is rare enough to pay for at once; commit() decides */
+    if (ledsDirty && bandMoved) ledsUrgent = true;
+}
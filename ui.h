@@ -9,6 +9,26 @@ namespace ui {
     /* call once from setup() */
     void init();
 
-    /* call every loop() – cheap; only touches the strip when something changed */
+    /* call every loop() – cheap; only redraws the pixel buffer, never shows */
     void refresh();
+
+    /* push the pixel buffer if anything is pending – the one strip.show().
+       idle = called from loop(): under external sync only an urgent frame
+       goes out there, the rest waits for the step edge (nextStep()).   */
+    void commit(bool idle = false);
+
+    /* LED views – every page is kept warm in a cached frame, so switching
+       is instant (no recompute, just a diff against what is on the strip) */
+    enum class Page : uint8_t {
+        Gate,       // gate / accent heat of the regular sequence (default)
+        Degree,     // scale degree per step, prospective (what plays next pass)
+        Octave,     // octave displacement per step, prospective
+        Diff,       // steps where prospect ≠ regular (what Copy would commit)
+        Prob,       // pot heat: 8 pitch sliders | 8 octave sliders
+        Count
+    };
+
+    void setPage(Page p);
+    void nextPage();
+    Page page();
 }
@@ -0,0 +1,151 @@
+/*  undo.cpp  ─────────────────────────────────────────────────────────────
+    Delta-record undo ring – see undo.h
+    ---------------------------------------------------------------------- */
+
+#include "undo.h"
+#include "sequencer.h"
+
+/* ───────── record layout (uint16_t) ────────────────────────────────────
+   bit 15     first record of a group
+   bit 14     rotate op (bit 0: 1 = was a left rotate)
+   bit 13     extra-lane record: lane index in bits 14 + 12 (hi, lo),
+              bits 0-7 the lane value – checked before bit 14
+   bit 8-11   step
+   bit 0-6    packed step (the value to put back)                       */
+namespace {
+
+    constexpr uint16_t R_GROUP  = 0x8000;
+    constexpr uint16_t R_ROTATE = 0x4000;
+    constexpr uint16_t R_LANE   = 0x2000;
+    constexpr uint8_t  kLanes   = 4;            // 2-bit lane index
+
+    static_assert((undo::kRecords & (undo::kRecords - 1)) == 0, "power of two");
+
+    uint16_t rec[undo::kRecords];
+    uint8_t  tail = 0, cur = 0, head = 0;      // free-running; cur = undo point
+
+    enum class Open : uint8_t { None, Commit, Live };
+    Open     open       = Open::None;
+    bool     groupEmpty = true;                // next record starts the group
+    uint16_t groupSteps = 0;                   // steps already logged in the group
+    uint16_t groupLane[kLanes] = {};           //   … per extra lane
+
+    inline uint16_t& at(uint8_t i) { return rec[i & (undo::kRecords - 1)]; }
+
+    void push(uint16_t r)
+    {
+        head = cur;                             // new history drops redo
+        if (uint8_t(head - tail) == undo::kRecords) {
+            do ++tail;                          // evict the oldest whole group
+            while (tail != head && !(at(tail) & R_GROUP));
+        }
+        at(head++) = r;
+        cur = head;
+    }
+
+    void open_(Open kind)
+    {
+        open = kind;
+        groupEmpty = true;
+        groupSteps = 0;
+        memset(groupLane, 0, sizeof groupLane);
+    }
+
+    /* coalesce: a step keeps the oldest value logged in the group */
+    void record(uint16_t& seen, uint8_t s, uint16_t r)
+    {
+        uint16_t bit = uint16_t(1) << (s & 0x0F);
+        if (seen & bit) return;
+        if (groupEmpty) r |= R_GROUP;
+        groupEmpty = false;
+        seen |= bit;
+        push(r);
+    }
+
+    void delta(uint8_t s, uint8_t oldPacked)
+    {
+        record(groupSteps, s, (uint16_t(s & 0x0F) << 8) | (oldPacked & 0x7F));
+    }
+
+    void laneDelta(uint8_t l, uint8_t s, uint8_t old)
+    {
+        if (l >= kLanes) return;
+        record(groupLane[l], s, R_LANE | (uint16_t(l & 1) << 12) | (uint16_t(l & 2) << 13)
+                              | (uint16_t(s & 0x0F) << 8) | old);
+    }
+
+    /* apply one record, leaving the inverse in its place */
+    void replay(uint16_t& r, bool forward)
+    {
+        if (r & R_LANE) {
+            uint8_t l   = ((r >> 12) & 1) | ((r >> 13) & 2);
+            uint8_t s   = (r >> 8) & 0x0F;
+            uint8_t now = seq::laneValue(l, s);
+            seq::setLaneValue(l, s, r & 0xFF);
+            r = (r & 0xFF00) | now;
+            return;
+        }
+        if (r & R_ROTATE) {
+            bool left = r & 1;
+            if (left == forward) seq::rotateAllLeft();
+            else                 seq::rotateAllRight();
+            return;
+        }
+        uint8_t s   = (r >> 8) & 0x0F;
+        uint8_t now = seq::packedStep(s);
+        seq::setPackedStep(s, r & 0x7F);
+        r = (r & R_GROUP) | (uint16_t(s) << 8) | now;
+    }
+}
+
+void undo::begin()                 { open_(Open::Commit); }
+void undo::step(uint8_t s, uint8_t v) { delta(s, v); }
+void undo::seal()                  { open = Open::None; }
+
+void undo::live(uint8_t s, uint8_t v)
+{
+    if (open != Open::Live) open_(Open::Live);
+    delta(s, v);
+}
+
+void undo::lane(uint8_t l, uint8_t s, uint8_t v) { laneDelta(l, s, v); }
+
+void undo::laneLive(uint8_t l, uint8_t s, uint8_t v)
+{
+    if (open != Open::Live) open_(Open::Live);
+    laneDelta(l, s, v);
+}
+
+void undo::rotate(bool left)
+{
+    open = Open::None;
+    push(R_GROUP | R_ROTATE | (left ? 1 : 0));
+}
+
+void undo::clear()
+{
+    tail = cur = head;
+    open = Open::None;
+}
+
+bool undo::undo()
+{
+    if (cur == tail) return false;
+    open = Open::None;
+    do {                                        // newest → oldest
+        --cur;
+        replay(at(cur), false);
+    } while (cur != tail && !(at(cur) & R_GROUP));
+    return true;
+}
+
+bool undo::redo()
+{
+    if (cur == head) return false;
+    open = Open::None;
+    do {                                        // oldest → newest
+        replay(at(cur), true);
+        ++cur;
+    } while (cur != head && !(at(cur) & R_GROUP));
+    return true;
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include <Arduino.h>
+
+/*  undo.h  ───────────────────────────────────────────────────────────────
+    Undo / redo for the regular sequence.  Mutations are logged as 2-byte
+    delta records (step + old packed step, step + old value of an extra
+    lane, or a rotate op) in a bounded ring and grouped per gesture: one
+    commit, one rotate, or one pass of destructive / instant writes
+    through the loop.  A step touched twice inside a group is only
+    logged once per lane.  Oldest groups fall off the end.  A pattern
+    Load clears the ring – its deltas belong to the old pattern.
+    ---------------------------------------------------------------------- */
+
+namespace undo {
+
+    constexpr uint8_t kRecords = 64;     // 128 B of SRAM
+
+    void begin();                        // open a new group (commit)
+    void step(uint8_t s, uint8_t oldPacked);   // delta into the open group
+    void live(uint8_t s, uint8_t oldPacked);   // delta into the running live group
+    void lane    (uint8_t l, uint8_t s, uint8_t old);   // extra lane l, open group
+    void laneLive(uint8_t l, uint8_t s, uint8_t old);   //   … running live group
+    void rotate(bool left);              // one-record group
+    void seal();                         // close the open group (loop wrap)
+
+    bool undo();                         // revert newest group – false if none
+    bool redo();                         // re-apply – false if none
+    void clear();                        // drop all history (pattern load)
+}
@@ -0,0 +1,115 @@
+/*  voices.cpp  ───────────────────────────────────────────────────────────
+    Voice allocation + running-status burst (see voices.h)
+    ---------------------------------------------------------------------- */
+
+#include "voices.h"
+#include "sysex.h"
+
+namespace {
+
+    constexpr uint8_t NOTE_ON = 0x90;         // channel 1
+    constexpr uint8_t CONTROL = 0xB0;
+    constexpr uint8_t kBurst  = 32;           // 1 status + 15 messages
+
+    struct Voice {
+        uint8_t pitch;
+        uint8_t refs;                         // 0 = free
+        uint8_t age;                          // stamp of the last strike
+    };
+
+    Voice   v[voice::kVoices];
+    uint8_t stamp = 0;
+
+    uint8_t burst[kBurst];
+    uint8_t burstLen = 0;
+    uint8_t running  = 0;                     // status in force inside the burst
+
+    void put(uint8_t status, uint8_t a, uint8_t b)
+    {
+        if (burstLen > kBurst - 3) voice::sendNow();
+        if (!burstLen || status != running)       // running status from here
+            burst[burstLen++] = running = status;
+        burst[burstLen++] = a & 0x7F;
+        burst[burstLen++] = b & 0x7F;
+    }
+    inline void put(uint8_t pitch, uint8_t vel) { put(NOTE_ON, pitch, vel); }
+
+    Voice* find(uint8_t pitch)
+    {
+        for (Voice& x : v) if (x.refs && x.pitch == pitch) return &x;
+        return nullptr;
+    }
+}
+
+void voice::on(uint8_t pitch, uint8_t vel)
+{
+    Voice* x = find(pitch);
+    if (x) {                                  // re-strike: keep the voice
+        if (x->refs < 255) ++x->refs;
+    } else {
+        Voice* oldest = &v[0];
+        for (Voice& y : v) {
+            if (!y.refs) { oldest = &y; break; }
+            if (uint8_t(stamp - y.age) > uint8_t(stamp - oldest->age)) oldest = &y;
+        }
+        x = oldest;
+        if (x->refs) put(x->pitch, 0);        // steal: its later offs find nothing
+        *x = { pitch, 1, 0 };
+    }
+    x->age = ++stamp;
+    put(pitch, vel);
+}
+
+void voice::off(uint8_t pitch)
+{
+    Voice* x = find(pitch);
+    if (!x || --x->refs) return;              // stolen, or still held by another hit
+    put(pitch, 0);
+}
+
+void voice::control(uint8_t num, uint8_t val) { put(CONTROL, num, val); }
+
+bool voice::held() { return sysex::sending(); }
+
+/* each burst starts with its status byte, so a dump in between never
+   leaves running status dangling                                      */
+void voice::send()
+{
+    if (!burstLen || held()) return;
+    Serial.write(burst, burstLen);
+    burstLen = 0;
+}
+
+void voice::sendNow()
+{
+    sysex::finish();
+    send();
+}
+
+void voice::allOff()
+{
+    for (Voice& x : v)
+        if (x.refs) { put(x.pitch, 0); x.refs = 0; }
+    put(CONTROL, 123, 0);                     // and anything a steal lost track of
+    send();
+}
+
+void voice::move(const uint8_t* from, const uint8_t* to, const uint8_t* refs,
+                 uint8_t n, uint8_t vel)
+{
+    uint8_t carry[kVoices];                   // refs actually taken per tone
+    for (uint8_t k = 0; k < n && k < kVoices; ++k) {
+        carry[k] = 0;
+        Voice* x = find(from[k]);
+        if (!x || !refs[k] || from[k] == to[k]) continue;   // ended or stolen
+        carry[k] = min(refs[k], x->refs);
+        x->refs -= carry[k];
+        if (!x->refs) put(from[k], 0);
+    }
+    for (uint8_t k = 0; k < n && k < kVoices; ++k) {
+        if (!carry[k]) continue;
+        on(to[k], vel);
+        find(to[k])->refs += carry[k] - 1;    // carries the queued offs over
+    }
+    send();
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <Arduino.h>
+
+/*  voices.h  ─────────────────────────────────────────────────────────────
+    Fixed voice table between the tick wheel and the UART.
+    Each sounding pitch holds one voice with a reference count, so
+    overlapping hits of the same pitch (ratchets, chord tones shared by
+    neighbouring steps) only send NoteOff when the last one ends.  When
+    all voices are busy the oldest is stolen.
+    Messages collect in a small burst buffer under running status
+    (NoteOff = NoteOn vel 0) and go out in one Serial.write() per tick.
+    This is the one writer of channel messages, and so the output gate:
+    a SysEx dump may not be split, so while one is in flight (held())
+    the burst stays here and the tick wheel holds its due ticks back.
+    ---------------------------------------------------------------------- */
+
+namespace voice {
+
+    constexpr uint8_t kVoices = 8;
+
+    void on  (uint8_t pitch, uint8_t vel);   // buffered
+    void off (uint8_t pitch);                // buffered, precise
+    void control(uint8_t num, uint8_t val);  // CC on the note channel, buffered
+    void send();                             // one write for the burst, unless held
+
+    bool held();                             // a SysEx dump owns the UART
+    void sendNow();                          // rare: finish the dump (blocks), then send
+
+    void allOff();                           // stop: every voice + CC 123
+    /* live transpose: refs[k] references leave from[k] and join to[k] –
+       all voices detach first, then attach, so tones trading pitches
+       never merge                                                     */
+    void move(const uint8_t* from, const uint8_t* to, const uint8_t* refs,
+              uint8_t n, uint8_t vel);
+}